@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <QApplication>
+#include <memory>
+#include "benchaccess.h"
+
+namespace {
+
+std::unique_ptr<MainWindow> s_mainWindow;
+std::unique_ptr<Certified> s_certified;
+
+// 앱 로그(qDebug)는 측정 시간을 왜곡하므로 경고 이상만 출력
+void benchMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+{
+    if (type == QtDebugMsg || type == QtInfoMsg)
+        return;
+    fprintf(stderr, "%s\n", qPrintable(message));
+}
+
+} // namespace
+
+// startServices() 는 부르지 않는다 - TCP/DB/변경 감지 없이 화면과 핸들러 경로만
+MainWindow& BenchAccess::mainWindow()
+{
+    if (!s_mainWindow)
+        s_mainWindow = std::make_unique<MainWindow>();
+    return *s_mainWindow;
+}
+
+Certified& BenchAccess::certified()
+{
+    if (!s_certified)
+        s_certified = std::make_unique<Certified>();
+    return *s_certified;
+}
+
+void BenchAccess::cleanup()
+{
+    s_mainWindow.reset();
+    s_certified.reset();
+}
+
+int main(int argc, char** argv)
+{
+    // 화면 없는 장비/CI 에서도 위젯을 만들 수 있도록
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    qInstallMessageHandler(benchMessageHandler);
+
+    QApplication app(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    BenchAccess::cleanup();
+    releaseSqliteStandIns();
+    return 0;
+}
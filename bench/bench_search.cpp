@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include "searchtablemodel.h"
+
+// Search 결과 표시 경로 - 페이지를 모델에 붙이는 비용과, 뷰가 보이는 행의 셀 문자열(날짜 포함)을 만드는 비용
+
+namespace {
+
+SearchPage makeHomeEnvPage(int rows)
+{
+    HomeEnvColumns columns;
+    columns.reserve(rows);
+    qint64 ts = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < rows; ++i) {
+        ts -= 10 * 1000;
+        columns.ts.append(ts);
+        columns.temperature.append(20.0f + float(i % 50) / 10.0f);
+        columns.humidity.append(40.0f + float(i % 30));
+        columns.illumination.append(300 + i % 200);
+    }
+
+    SearchPage page;
+    page.category = SearchCategory::HomeEnv;
+    page.columns = columns;
+    return page;
+}
+
+SearchPage makeEventPage(SearchCategory category, int rows)
+{
+    EventColumns columns;
+    columns.reserve(rows);
+    const quint16 normal = columns.statusNames.intern("정상");
+    const quint16 danger = columns.statusNames.intern("위험");
+    qint64 ts = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < rows; ++i) {
+        ts -= 10 * 1000;
+        columns.ts.append(ts);
+        columns.status.append(i % 100 == 0 ? danger : normal);
+        columns.level.append(float(i % 500));
+    }
+
+    SearchPage page;
+    page.category = category;
+    page.columns = columns;
+    return page;
+}
+
+// 한 화면에 보이는 행 수
+const int kVisibleRows = 40;
+
+} // namespace
+
+static void BM_SearchModelAppendPage(benchmark::State& state)
+{
+    const SearchPage page = makeHomeEnvPage(int(state.range(0)));
+    for (auto _ : state) {
+        SearchTableModel model;
+        model.reset(SearchCategory::HomeEnv);
+        model.appendPage(page);
+        benchmark::DoNotOptimize(model.rowCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SearchModelAppendPage)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// 500행 페이지를 여러 번 이어 붙이는 실제 스크롤 경로
+static void BM_SearchModelAppendPaged(benchmark::State& state)
+{
+    const int rows = int(state.range(0));
+    const SearchPage page = makeEventPage(SearchCategory::Fire, 500);
+    for (auto _ : state) {
+        SearchTableModel model;
+        model.reset(SearchCategory::Fire);
+        for (int added = 0; added < rows; added += 500)
+            model.appendPage(page);
+        benchmark::DoNotOptimize(model.rowCount());
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_SearchModelAppendPaged)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// 보이는 행의 날짜/분류/값 문자열 생성 (예전 formatDateTime + populate*Data 에 해당)
+static void BM_SearchModelVisibleRows(benchmark::State& state)
+{
+    const int rows = int(state.range(0));
+    SearchTableModel model;
+    model.reset(SearchCategory::HomeEnv);
+    model.appendPage(makeHomeEnvPage(rows));
+
+    QRandomGenerator random(1234);
+    for (auto _ : state) {
+        const int first = random.bounded(qMax(1, model.rowCount() - kVisibleRows));
+        for (int row = first; row < qMin(model.rowCount(), first + kVisibleRows); ++row) {
+            for (int column = 0; column < model.columnCount(); ++column)
+                benchmark::DoNotOptimize(model.data(model.index(row, column)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kVisibleRows);
+}
+BENCHMARK(BM_SearchModelVisibleRows)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
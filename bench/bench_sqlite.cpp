@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QTemporaryDir>
+#include <QDebug>
+#include "benchaccess.h"
+#include "database.h"
+
+// MySQL 대신 SQLite 파일 DB 로 Database 의 검색/최신 값 조회를 측정
+// - Database 를 QSQLITE 풀로 설정해 앱과 같은 메서드(같은 SQL, 같은 준비 문장 캐시)를 그대로 호출한다
+// - SQLite 스키마는 시각을 MySQL DATETIME 대신 epoch ms 정수로 저장한다 (Database::configure 참고)
+// - 인덱스는 schemamigrator.cpp 의 home_env 인덱스와 같게 유지
+// - 행 수별로 home_id 를 따로 두고 (home_id = 행 수) 처음 쓸 때 채운다
+
+namespace {
+
+const qint64 kBaseMs = 1700000000000LL;
+const qint64 kSampleIntervalMs = 10 * 1000;
+const int kPageSize = 500;
+const char* const kSetupConnection = "bench_sqlite_setup";
+
+struct StandIn
+{
+    QTemporaryDir dir;
+    QHash<int, qint64> firstIds;    // 행 수 -> 그 home_id 의 첫 행 id
+};
+
+StandIn* s_standIn = nullptr;
+
+bool exec(QSqlQuery& query, const QString& sql)
+{
+    if (query.exec(sql))
+        return true;
+    qWarning() << "SQLite 쿼리 실패:" << sql << query.lastError().text();
+    return false;
+}
+
+// 데이터를 채우는 전용 연결 (Database 의 풀과 같은 파일)
+QSqlDatabase setupDatabase()
+{
+    return QSqlDatabase::database(kSetupConnection, false);
+}
+
+StandIn* standIn()
+{
+    if (s_standIn)
+        return s_standIn;
+
+    s_standIn = new StandIn;
+    const QString path = s_standIn->dir.filePath("bench.sqlite");
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", kSetupConnection);
+    db.setDatabaseName(path);
+    QSqlQuery query(db);
+    if (!db.open()
+        || !exec(query, "CREATE TABLE home_env (id INTEGER PRIMARY KEY, home_id TEXT NOT NULL, "
+                        "temperature REAL, humidity REAL, illumination INTEGER, measured_at INTEGER NOT NULL)")
+        || !exec(query, "CREATE INDEX idx_home_env_home_time "
+                        "ON home_env (home_id, measured_at, temperature, humidity, illumination)")
+        || !exec(query, "CREATE INDEX idx_home_env_home_id ON home_env (home_id, id, temperature, humidity)")) {
+        qWarning() << "SQLite 대체 DB 생성 실패:" << db.lastError().text();
+        return nullptr;
+    }
+
+    ConnectionPool::Config config;
+    config.driver = "QSQLITE";
+    config.dbName = path;
+    Database::instance().configure(config);
+    return s_standIn;
+}
+
+QString homeId(int rows)
+{
+    return QString::number(rows);
+}
+
+// home_id = rows 로 10초 간격 샘플 rows 개 생성 (한 번만)
+bool ensureRows(int rows)
+{
+    StandIn* s = standIn();
+    if (!s)
+        return false;
+    if (s->firstIds.contains(rows))
+        return true;
+
+    QSqlDatabase db = setupDatabase();
+    QSqlQuery query(db);
+    db.transaction();
+    query.prepare("INSERT INTO home_env (home_id, temperature, humidity, illumination, measured_at) "
+                  "VALUES (?, ?, ?, ?, ?)");
+    qint64 firstId = 0;
+    for (int i = 0; i < rows; ++i) {
+        query.bindValue(0, homeId(rows));
+        query.bindValue(1, 20.0 + (i % 50) / 10.0);
+        query.bindValue(2, 40.0 + i % 30);
+        query.bindValue(3, 300 + i % 200);
+        query.bindValue(4, kBaseMs + qint64(i) * kSampleIntervalMs);
+        if (!query.exec()) {
+            qWarning() << "SQLite 삽입 실패:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+        if (i == 0)
+            firstId = query.lastInsertId().toLongLong();
+    }
+    db.commit();
+    exec(query, "ANALYZE");
+
+    s->firstIds.insert(rows, firstId);
+    return true;
+}
+
+qint64 lastMs(int rows)
+{
+    return kBaseMs + qint64(rows - 1) * kSampleIntervalMs;
+}
+
+} // namespace
+
+void releaseSqliteStandIns()
+{
+    // 현재 스레드의 풀 연결을 닫은 뒤 임시 파일 삭제
+    Database::instance().disconnect();
+    QSqlDatabase::removeDatabase(kSetupConnection);
+    delete s_standIn;
+    s_standIn = nullptr;
+}
+
+// 최신 페이지 (검색 화면을 처음 열 때)
+static void BM_SqliteSearchFirstPage(benchmark::State& state)
+{
+    const int rows = int(state.range(0));
+    if (!ensureRows(rows)) {
+        state.SkipWithError("SQLite 대체 DB 준비 실패");
+        return;
+    }
+    Database& db = Database::instance();
+
+    for (auto _ : state) {
+        std::optional<SearchPage> page = db.getSearchPage(SearchCategory::HomeEnv, homeId(rows),
+                                                          kBaseMs, lastMs(rows), SearchCursor(), kPageSize);
+        benchmark::DoNotOptimize(page);
+    }
+    state.SetItemsProcessed(state.iterations() * kPageSize);
+}
+BENCHMARK(BM_SqliteSearchFirstPage)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+// 범위 중간의 페이지 (스크롤을 한참 내린 뒤) - 키셋이면 깊이와 무관해야 한다
+static void BM_SqliteSearchDeepPage(benchmark::State& state)
+{
+    const int rows = int(state.range(0));
+    if (!ensureRows(rows)) {
+        state.SkipWithError("SQLite 대체 DB 준비 실패");
+        return;
+    }
+    Database& db = Database::instance();
+    SearchCursor middle;
+    middle.id = s_standIn->firstIds.value(rows) + rows / 2;
+    middle.timeMs = kBaseMs + qint64(rows / 2) * kSampleIntervalMs;
+
+    for (auto _ : state) {
+        std::optional<SearchPage> page = db.getSearchPage(SearchCategory::HomeEnv, homeId(rows),
+                                                          kBaseMs, lastMs(rows), middle, kPageSize);
+        benchmark::DoNotOptimize(page);
+    }
+    state.SetItemsProcessed(state.iterations() * kPageSize);
+}
+BENCHMARK(BM_SqliteSearchDeepPage)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+// 구간 집계 (1시간) - 범위 전체를 읽으므로 행 수에 비례
+static void BM_SqliteSearchAggregate(benchmark::State& state)
+{
+    const int rows = int(state.range(0));
+    if (!ensureRows(rows)) {
+        state.SkipWithError("SQLite 대체 DB 준비 실패");
+        return;
+    }
+    Database& db = Database::instance();
+
+    for (auto _ : state) {
+        std::optional<SearchPage> page = db.getSearchAggregate(SearchCategory::HomeEnv, homeId(rows),
+                                                               kBaseMs, lastMs(rows), SearchBucket::Hour);
+        benchmark::DoNotOptimize(page);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_SqliteSearchAggregate)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// 최신 값 (대시보드 카드) - 풀의 준비 문장을 재사용하는 getLatestHomeEnv
+static void BM_SqliteLatestHomeEnv(benchmark::State& state)
+{
+    const int rows = 100000;
+    if (!ensureRows(rows)) {
+        state.SkipWithError("SQLite 대체 DB 준비 실패");
+        return;
+    }
+    Database& db = Database::instance();
+
+    for (auto _ : state) {
+        std::optional<QPair<double, double>> latest = db.getLatestHomeEnv(homeId(rows));
+        benchmark::DoNotOptimize(latest);
+    }
+}
+BENCHMARK(BM_SqliteLatestHomeEnv)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+#include <iterator>
+#include "benchaccess.h"
+
+namespace {
+
+// 서버가 실제로 보내는 메시지 종류별 (센서 값 / 이벤트 / 창문 상태 JSON / 명령 확인)
+const char* const kTcpMessages[] = {
+    "PLANT:45",
+    "GAS:120",
+    "FIRE:0",
+    "PET:POOP",
+    "EVT OPENED",
+    "ACK OPEN",
+    "{\"pose\":\"OPEN\",\"angle\":100}",
+};
+
+cv::Mat makeFrame(int width, int height)
+{
+    cv::Mat frame(height, width, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    return frame;
+}
+
+} // namespace
+
+static void BM_TcpMessageReceived(benchmark::State& state)
+{
+    MainWindow& window = BenchAccess::mainWindow();
+    const QByteArray message(kTcpMessages[state.range(0)]);
+    state.SetLabel(kTcpMessages[state.range(0)]);
+
+    for (auto _ : state)
+        BenchAccess::tcpEvent(window, ProtocolParser::parseLine(message.constData(), message.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TcpMessageReceived)->DenseRange(0, int(std::size(kTcpMessages)) - 1);
+
+// 수신 버퍼 해석만 (UI 갱신 제외) - 센서 값 1000 건이 한 번에 들어온 경우, 0 = 텍스트 / 1 = 바이너리 프레임
+static void BM_ProtocolParser(benchmark::State& state)
+{
+    const bool binary = state.range(0) == 1;
+    QByteArray stream;
+    for (int i = 0; i < 1000; ++i) {
+        const QByteArray message = kTcpMessages[i % 4];
+        stream += binary ? Protocol::encodeMessage(message) : message + '\n';
+    }
+    state.SetLabel(binary ? "binary" : "text");
+
+    ProtocolParser parser;
+    parser.setMode(binary ? ProtocolParser::Mode::Binary : ProtocolParser::Mode::Text);
+    qint64 sum = 0;
+    for (auto _ : state) {
+        parser.append(stream.constData(), stream.size());
+        parser.parse([&sum](const SensorEvent& event) { sum += event.value; });
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 1000);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_ProtocolParser)->Arg(0)->Arg(1);
+
+static void BM_LoadResourceImage(benchmark::State& state)
+{
+    MainWindow& window = BenchAccess::mainWindow();
+    const QSize size(int(state.range(0)), int(state.range(0)));
+
+    for (auto _ : state) {
+        QPixmap pixmap = BenchAccess::loadResourceImage(window, ":/res/poo.png", size);
+        benchmark::DoNotOptimize(pixmap);
+    }
+}
+BENCHMARK(BM_LoadResourceImage)->Arg(70)->Arg(200)->Unit(benchmark::kMicrosecond);
+
+static void BM_MatToQImage(benchmark::State& state)
+{
+    Certified& certified = BenchAccess::certified();
+    const cv::Mat frame = makeFrame(int(state.range(0)), int(state.range(1)));
+
+    for (auto _ : state) {
+        QImage image = BenchAccess::matToQImage(certified, frame);
+        benchmark::DoNotOptimize(image);
+    }
+    state.SetBytesProcessed(state.iterations() * qint64(frame.total() * frame.elemSize()));
+}
+BENCHMARK(BM_MatToQImage)->Args({ 640, 480 })->Args({ 1280, 720 })->Unit(benchmark::kMicrosecond);
+
+static void BM_CropFace128(benchmark::State& state)
+{
+    // 얼굴 검출기(xml)가 없으면 센터 크롭만 측정된다
+    Certified& certified = BenchAccess::certified();
+    const cv::Mat frame = makeFrame(int(state.range(0)), int(state.range(1)));
+
+    for (auto _ : state) {
+        cv::Mat crop = BenchAccess::cropFace128(certified, frame);
+        benchmark::DoNotOptimize(crop.data);
+    }
+}
+BENCHMARK(BM_CropFace128)->Args({ 640, 480 })->Unit(benchmark::kMillisecond);
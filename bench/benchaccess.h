@@ -0,0 +1,39 @@
+#ifndef BENCHACCESS_H
+#define BENCHACCESS_H
+
+#include "mainwindow.h"
+#include "certified.h"
+
+// 벤치마크에서 위젯의 private 헬퍼를 직접 호출하기 위한 접근자 (MainWindow/Certified 의 friend)
+// 위젯은 처음 쓸 때 한 번만 만들고, QApplication 이 끝나기 전에 cleanup() 으로 정리한다
+struct BenchAccess
+{
+    static MainWindow& mainWindow();
+    static Certified& certified();
+    static void cleanup();
+
+    static void tcpEvent(MainWindow& window, const SensorEvent& event)
+    {
+        window.onTcpEvent(event);
+    }
+
+    static QPixmap loadResourceImage(MainWindow& window, const QString& path, const QSize& size)
+    {
+        return window.loadResourceImage(path, size);
+    }
+
+    static QImage matToQImage(Certified& certified, const cv::Mat& mat)
+    {
+        return certified.matToQImage(mat);
+    }
+
+    static cv::Mat cropFace128(Certified& certified, const cv::Mat& bgr)
+    {
+        return certified.cropFace128(bgr);
+    }
+};
+
+// bench_sqlite.cpp - SQLite 대체 DB 정리 (QApplication 이 끝나기 전에)
+void releaseSqliteStandIns();
+
+#endif // BENCHACCESS_H
@@ -12,6 +12,8 @@
 #include <QCoreApplication>
 #include <QShowEvent>
 #include <QHideEvent>
+#include <QDebug>
+#include "profiler.h"
 
 //=============================================================================
 // COLOR CONSTANTS - Match Main Dashboard
@@ -24,6 +26,7 @@ const QColor CameraAreaGray(0xE8, 0xE8, 0xE8);      // #E8E8E8 - Camera area bac
 
 Certified::Certified(QWidget *parent) : QWidget(parent)
 {
+    PROFILE_SCOPE("Certified::Certified");
     setupFonts();
     setupUI();
     setupStyles();
@@ -482,35 +485,8 @@ cv::Mat Certified::cropFace128(const cv::Mat& bgr) {
     return crop;
 }
 
-// ====== DB 연결 ======
-bool Certified::openDb() {
-    if (db.isValid() && db.isOpen()) return true;
-
-    // 연결명: EnrollConnection (팀 결정사항)
-    if (QSqlDatabase::contains("hometer"))
-        db = QSqlDatabase::database("hometer");
-    else
-        db = QSqlDatabase::addDatabase("QMYSQL", "hometer");
-
-    // ★ 현재는 요청하신 값으로 직접 연결 (후에 JSON/env 로 전환 가능)
-    db.setHostName("127.0.0.1");
-    db.setPort(3306);
-    db.setDatabaseName("hometer");
-    db.setUserName("root");
-    db.setPassword("1111");  // <- 추후 ConfigLoader로 치환 권장
-
-    if (!db.open()) {
-        if (statusLabel) statusLabel->setText("DB 연결 실패: " + db.lastError().text());
-        qWarning() << "DB open failed:" << db.lastError().text();
-        return false;
-    }
-    return true;
-}
-
 // ====== 1장 INSERT ======
 bool Certified::insertFaceImage(int uid, const QString& uname, const cv::Mat& bgr) {
-    if (!openDb()) return false;
-
     // 1) 얼굴/센터 크롭 128x128
     cv::Mat crop = cropFace128(bgr);
 
@@ -522,16 +498,10 @@ bool Certified::insertFaceImage(int uid, const QString& uname, const cv::Mat& bg
     }
     QByteArray ba(reinterpret_cast<const char*>(buf.data()), static_cast<int>(buf.size()));
 
-    // 3) INSERT
-    QSqlQuery q(db);
-    q.prepare("INSERT INTO face_images (user_id, user_name, face_data) VALUES (?, ?, ?)");
-    q.addBindValue(uid);
-    q.addBindValue(uname);
-    q.addBindValue(ba);
-
-    if (!q.exec()) {
-        qWarning() << "INSERT failed:" << q.lastError().text();
-        if (statusLabel) statusLabel->setText("DB 저장 실패: " + q.lastError().text());
+    // 3) INSERT - 대시보드/검색과 같은 연결 풀에서 빌린 연결 사용
+    QString error;
+    if (!Database::instance().insertFaceImage(uid, uname, ba, &error)) {
+        if (statusLabel) statusLabel->setText("DB 저장 실패: " + error);
         return false;
     }
     return true;
@@ -571,6 +541,7 @@ void Certified::stopCamera() {
 // ====== 프레임 틱 ======
 void Certified::onFrameTick() {
     if (!cameraRunning) return;
+    PROFILE_SCOPE("Certified::onFrameTick");
 
     cv::Mat frame;
     if (!cap.read(frame) || frame.empty()) {
@@ -765,7 +736,10 @@ void Certified::onRegisterClicked() {
     currentUserId = uid;
     currentUserName = uname;
 
-    if (!openDb()) return;
+    if (!Database::instance().isConnected()) {
+        if (statusLabel) statusLabel->setText("DB 연결 실패");
+        return;
+    }
 
     if (!cameraRunning) startCamera(0);
 
@@ -14,15 +14,14 @@
 #include <QGraphicsDropShadowEffect>
 #include <QTimer>
 #include <QImage>
-#include <QSqlDatabase>
-#include <QSqlQuery>
-#include <QSqlError>
+#include "database.h"
 
 #include <opencv2/opencv.hpp>
 
 class Certified : public QWidget
 {
     Q_OBJECT
+    friend struct BenchAccess;  // bench/benchaccess.h - private 헬퍼 측정용
 
 public:
     explicit Certified(QWidget *parent = nullptr);
@@ -94,8 +93,6 @@ private:
     int   burstTarget = 15;
 
     // ---------- DB ----------
-    QSqlDatabase db;
-    bool openDb();                           // DB 오픈 (MySQL)
     bool insertFaceImage(int uid, const QString& uname, const cv::Mat& bgr); // 1장 insert
 
     int currentUserId = -1;
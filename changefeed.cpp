@@ -0,0 +1,60 @@
+#include "changefeed.h"
+
+ChangeFeed::ChangeFeed(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_probeInFlight(false)
+{
+    connect(m_timer, &QTimer::timeout, this, &ChangeFeed::probe);
+}
+
+void ChangeFeed::start(int intervalMs)
+{
+    m_timer->start(intervalMs);
+    probe();
+}
+
+void ChangeFeed::stop()
+{
+    m_timer->stop();
+}
+
+void ChangeFeed::probe()
+{
+    // DB 가 느려 이전 조회가 아직 돌아오지 않았거나, DB 없이 동작 중이면 건너뜀
+    if (m_probeInFlight || !Database::instance().isConnected())
+        return;
+
+    m_probeInFlight = true;
+    Database::instance()
+        .getTableWatermarksAsync()
+        .then(this, [this](std::optional<TableWatermarks> current) {
+            m_probeInFlight = false;
+            if (current.has_value())
+                compare(current.value());
+        })
+        .onCanceled(this, [this]() {
+            // DB 작업 스레드가 멈춰 결과 없이 취소된 경우에도 다음 조회가 막히지 않도록
+            m_probeInFlight = false;
+        });
+}
+
+void ChangeFeed::compare(const TableWatermarks& current)
+{
+    if (!m_last.has_value()) {
+        m_last = current;
+        return;
+    }
+
+    const TableWatermarks previous = m_last.value();
+    m_last = current;
+
+    if (current.homeEnv > previous.homeEnv)
+        emit homeEnvChanged(previous.homeEnv);
+    if (current.fireEvents > previous.fireEvents)
+        emit fireEventsChanged(previous.fireEvents);
+    if (current.plantEnv > previous.plantEnv)
+        emit plantEnvChanged(previous.plantEnv);
+    if (current.petStatus > previous.petStatus)
+        emit petStatusChanged(previous.petStatus);
+}
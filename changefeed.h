@@ -0,0 +1,40 @@
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+#include <QObject>
+#include <QTimer>
+#include <optional>
+#include "database.h"
+
+// 센서 테이블 변경 감지
+// - 주기적으로 테이블별 MAX(id) 워터마크만 조회 (PK 인덱스만 보는 가벼운 쿼리)
+// - 워터마크가 올라간 테이블에 대해서만 변경 시그널을 보내, 카드가 새 행이 있을 때만 갱신되도록 함
+// - 시그널의 sinceId 는 직전 워터마크로, 받는 쪽은 id > sinceId 인 행만 증분 조회하면 된다
+class ChangeFeed : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ChangeFeed(QObject *parent = nullptr);
+
+    void start(int intervalMs = 1000);
+    void stop();
+
+signals:
+    void homeEnvChanged(qint64 sinceId);
+    void fireEventsChanged(qint64 sinceId);
+    void plantEnvChanged(qint64 sinceId);
+    void petStatusChanged(qint64 sinceId);
+
+private slots:
+    void probe();
+
+private:
+    void compare(const TableWatermarks& current);
+
+    QTimer *m_timer;
+    bool m_probeInFlight;
+    std::optional<TableWatermarks> m_last;  // 첫 조회는 기준값으로만 사용
+};
+
+#endif // CHANGEFEED_H
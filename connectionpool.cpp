@@ -0,0 +1,280 @@
+#include "connectionpool.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QMutexLocker>
+#include <QDeadlineTimer>
+#include <QDebug>
+
+//=============================================================================
+// Lease
+//=============================================================================
+ConnectionPool::Lease::Lease(ConnectionPool* pool, const QString& name)
+    : m_pool(pool)
+    , m_name(name)
+{
+}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : m_pool(other.m_pool)
+    , m_name(std::move(other.m_name))
+{
+    other.m_pool = nullptr;
+}
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other) {
+        if (m_pool)
+            m_pool->release(m_name);
+        m_pool = other.m_pool;
+        m_name = std::move(other.m_name);
+        other.m_pool = nullptr;
+    }
+    return *this;
+}
+
+ConnectionPool::Lease::~Lease()
+{
+    if (m_pool)
+        m_pool->release(m_name);
+}
+
+QSqlDatabase ConnectionPool::Lease::database() const
+{
+    return QSqlDatabase::database(m_name, false);
+}
+
+QSqlQuery* ConnectionPool::Lease::prepared(const QString& id, const QString& sql)
+{
+    if (!m_pool)
+        return nullptr;
+    return m_pool->preparedStatement(m_name, id, sql);
+}
+
+//=============================================================================
+// ConnectionPool
+//=============================================================================
+ConnectionPool::~ConnectionPool()
+{
+    closeAll();
+}
+
+void ConnectionPool::configure(const Config& config)
+{
+    QMutexLocker locker(&m_mutex);
+    m_config = config;
+}
+
+int ConnectionPool::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+ConnectionPool::Lease ConnectionPool::acquire(int timeoutMs)
+{
+    QThread* thread = QThread::currentThread();
+    QDeadlineTimer deadline(timeoutMs);
+
+    QMutexLocker locker(&m_mutex);
+
+    // 1) 이 스레드의 연결이 이미 있으면 재사용
+    auto it = m_entries.find(thread);
+    if (it != m_entries.end()) {
+        Entry& entry = it.value();
+        const QString name = entry.name;
+        const bool idle = entry.leases == 0;
+        const qint64 idleMs = entry.lastUsed.elapsed();
+        const bool expired = idle && idleMs > IdleTimeoutMs;
+        const bool needsCheck = idle && idleMs > HealthCheckIntervalMs;
+        ++entry.leases;
+        locker.unlock();
+
+        // 오래 쉬던 연결은 새로 열고, 잠깐 쉬던 연결은 상태만 확인
+        bool reconnect = false;
+        if (expired) {
+            qDebug() << "DB 연결 유휴 시간 초과, 재연결:" << name;
+            reconnect = true;
+        } else if (needsCheck && !isHealthy(name)) {
+            qDebug() << "DB 연결 상태 확인 실패, 재연결:" << name;
+            reconnect = true;
+        }
+
+        if (reconnect) {
+            dropStatements(thread);
+            removeConnection(name);
+            if (!openConnection(name)) {
+                releaseThreadConnection();
+                return Lease();
+            }
+        }
+        return Lease(this, name);
+    }
+
+    // 2) 새 연결 - 풀이 가득 찼으면 연결을 가진 다른 스레드가 끝날 때까지 대기 (releaseThreadConnection 이 깨움)
+    while (m_entries.size() >= MaxConnections) {
+        if (!m_slotFreed.wait(&m_mutex, deadline)) {
+            qWarning() << "DB 연결 풀 대기 시간 초과 (최대" << MaxConnections << "개)";
+            return Lease();
+        }
+    }
+
+    Entry entry;
+    entry.name = QString("hometer_pool_%1").arg(++m_nextId);
+    entry.leases = 1;
+    entry.lastUsed.start();
+
+    // 스레드가 끝나면 그 스레드 위에서 연결 정리 (finished 는 해당 스레드에서 발생)
+    entry.finishedHook = QObject::connect(thread, &QThread::finished, [this]() {
+        releaseThreadConnection();
+    });
+
+    const QString name = entry.name;
+    m_entries.insert(thread, entry);
+    locker.unlock();
+
+    if (!openConnection(name)) {
+        releaseThreadConnection();
+        return Lease();
+    }
+    return Lease(this, name);
+}
+
+void ConnectionPool::release(const QString& name)
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it.value().name == name) {
+            --it.value().leases;
+            it.value().lastUsed.restart();
+            return;
+        }
+    }
+}
+
+QSqlQuery* ConnectionPool::preparedStatement(const QString& name, const QString& id, const QString& sql)
+{
+    QThread* thread = QThread::currentThread();
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(thread);
+        if (it == m_entries.end() || it.value().name != name)
+            return nullptr;
+
+        auto cached = it.value().statements.constFind(id);
+        if (cached != it.value().statements.constEnd()) {
+            QSqlQuery* query = cached.value().data();
+            query->finish();  // 이전 결과셋 해제, 준비 상태와 바인딩 자리는 유지
+            return query;
+        }
+    }
+
+    // 처음 쓰는 쿼리 - 이 스레드의 연결에서 한 번만 prepare
+    QSharedPointer<QSqlQuery> query(new QSqlQuery(QSqlDatabase::database(name, false)));
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        qDebug() << "쿼리 준비 실패:" << id << query->lastError().text();
+        return nullptr;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.find(thread);
+    if (it == m_entries.end())
+        return nullptr;
+    it.value().statements.insert(id, query);
+    return query.data();
+}
+
+void ConnectionPool::dropStatements(QThread* thread)
+{
+    // QSqlQuery 는 연결을 닫기 전에, 연결을 소유한 스레드에서 해제되어야 한다
+    QHash<QString, QSharedPointer<QSqlQuery>> statements;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(thread);
+        if (it == m_entries.end())
+            return;
+        statements.swap(it.value().statements);
+    }
+    statements.clear();
+}
+
+void ConnectionPool::releaseThreadConnection()
+{
+    QThread* thread = QThread::currentThread();
+    dropStatements(thread);
+
+    QString name;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(thread);
+        if (it == m_entries.end())
+            return;
+        name = it.value().name;
+        QObject::disconnect(it.value().finishedHook);
+        m_entries.erase(it);
+    }
+
+    removeConnection(name);
+    m_slotFreed.wakeAll();
+}
+
+void ConnectionPool::closeAll()
+{
+    releaseThreadConnection();
+
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        // 다른 스레드 소유 연결은 그 스레드가 끝날 때 정리되어야 정상
+        qWarning() << "DB 연결이 소유 스레드 밖에서 정리됨:" << it.value().name;
+        QObject::disconnect(it.value().finishedHook);
+        it.value().statements.clear();
+        removeConnection(it.value().name);
+    }
+    m_entries.clear();
+    m_slotFreed.wakeAll();
+}
+
+bool ConnectionPool::openConnection(const QString& name)
+{
+    Config config;
+    {
+        QMutexLocker locker(&m_mutex);
+        config = m_config;
+    }
+
+    QSqlDatabase db = QSqlDatabase::addDatabase(config.driver, name);
+    db.setHostName(config.host);
+    db.setDatabaseName(config.dbName);
+    db.setUserName(config.user);
+    db.setPassword(config.password);
+    db.setPort(config.port);
+    if (config.driver == "QMYSQL")
+        db.setConnectOptions(QString("MYSQL_OPT_CONNECT_TIMEOUT=%1").arg(config.connectTimeoutSec));
+
+    if (!db.open()) {
+        qDebug() << "DB 연결 실패:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool ConnectionPool::isHealthy(const QString& name)
+{
+    QSqlDatabase db = QSqlDatabase::database(name, false);
+    if (!db.isOpen())
+        return false;
+
+    QSqlQuery query(db);
+    return query.exec("SELECT 1");
+}
+
+void ConnectionPool::removeConnection(const QString& name)
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        if (db.isOpen())
+            db.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+}
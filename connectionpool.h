@@ -0,0 +1,109 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QString>
+#include <QSqlDatabase>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QSqlQuery>
+#include <QSharedPointer>
+
+// 스레드별 QSqlDatabase 연결 풀
+// - Qt 규칙상 연결은 만든 스레드에서만 쓸 수 있으므로 스레드마다 전용 연결을 하나씩 둔다
+// - 전체 연결 수는 MaxConnections 로 제한, 초과 시 연결을 가진 다른 스레드가 끝나 연결이 닫힐 때까지 대기
+//   (Lease 반납은 연결을 닫지 않으므로 자리가 나지 않는다 - 연결은 만든 스레드에서만 닫을 수 있음)
+// - 오래 쉬던 연결은 재사용 전에 SELECT 1 로 확인하고, IdleTimeoutMs 가 지나면 새로 연다
+// - 연결을 빌린 스레드가 끝나면 그 스레드 위에서 자동으로 연결을 닫는다
+// - 연결마다 준비된 문장(prepared statement)을 쿼리 id 로 캐시해 매번 prepare 하지 않는다
+class ConnectionPool
+{
+public:
+    struct Config
+    {
+        QString driver = "QMYSQL";
+        QString host;
+        QString dbName;
+        QString user;
+        QString password;
+        int port = 3306;
+        int connectTimeoutSec = 3;  // 서버가 없을 때 접속 시도가 오래 걸리지 않도록
+    };
+
+    // 빌린 연결 - 스코프를 벗어나면 자동 반납
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        bool isValid() const { return m_pool != nullptr; }
+        QSqlDatabase database() const;
+
+        // id 로 캐시된 준비 문장 반환 (처음이면 sql 로 prepare). 실패 시 nullptr
+        // 반환된 쿼리는 값만 다시 바인딩해서 exec() 하면 된다
+        QSqlQuery* prepared(const QString& id, const QString& sql);
+
+    private:
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, const QString& name);
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ConnectionPool* m_pool = nullptr;
+        QString m_name;
+    };
+
+    ConnectionPool() = default;
+    ~ConnectionPool();
+
+    void configure(const Config& config);
+
+    // 현재 스레드의 연결을 빌림 (없으면 생성). 실패 시 isValid() == false
+    Lease acquire(int timeoutMs = 3000);
+
+    // 현재 스레드가 가진 연결을 닫고 풀에서 제거
+    void releaseThreadConnection();
+
+    // 모든 연결 정리 (종료 시 GUI 스레드에서 호출)
+    void closeAll();
+
+    int size() const;
+
+private:
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    struct Entry
+    {
+        QString name;
+        int leases = 0;
+        QElapsedTimer lastUsed;
+        QMetaObject::Connection finishedHook;
+        QHash<QString, QSharedPointer<QSqlQuery>> statements;  // 쿼리 id -> 준비 문장
+    };
+
+    void release(const QString& name);
+    QSqlQuery* preparedStatement(const QString& name, const QString& id, const QString& sql);
+    void dropStatements(QThread* thread);
+    bool openConnection(const QString& name);
+    static bool isHealthy(const QString& name);
+    static void removeConnection(const QString& name);
+
+    static constexpr int MaxConnections = 4;
+    static constexpr int IdleTimeoutMs = 5 * 60 * 1000;
+    static constexpr int HealthCheckIntervalMs = 30 * 1000;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_slotFreed;     // 스레드 연결이 닫혀 풀에 자리가 났을 때
+    QHash<QThread*, Entry> m_entries;
+    Config m_config;
+    quint64 m_nextId = 0;
+};
+
+#endif // CONNECTIONPOOL_H
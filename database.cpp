@@ -1,7 +1,14 @@
 #include "database.h"
+#include "schemamigrator.h"
+#include "profiler.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
+#include <QDateTime>
+#include <QTimeZone>
+#include <QMap>
+#include <limits>
+#include <type_traits>
 
 Database& Database::instance()
 {
@@ -9,37 +16,77 @@ Database& Database::instance()
     return db;
 }
 
+void Database::configure(const QString& host,
+                         const QString& dbName,
+                         const QString& user,
+                         const QString& password,
+                         int port)
+{
+    ConnectionPool::Config config;
+    config.host = host;
+    config.dbName = dbName;
+    config.user = user;
+    config.password = password;
+    config.port = port;
+    configure(config);
+}
+
+void Database::configure(const ConnectionPool::Config& config)
+{
+    m_epochMsTime = config.driver == "QSQLITE";
+    m_pool.configure(config);
+}
+
 bool Database::connect(const QString& host,
                        const QString& dbName,
                        const QString& user,
                        const QString& password,
                        int port)
 {
-    if (m_db.isOpen())
+    if (m_connected)
         return true;
 
-    m_db = QSqlDatabase::addDatabase("QMYSQL");
-    m_db.setHostName(host);
-    m_db.setDatabaseName(dbName);
-    m_db.setUserName(user);
-    m_db.setPassword(password);
-    m_db.setPort(port);
+    configure(host, dbName, user, password, port);
+    return open();
+}
 
-    if (!m_db.open()) {
-        qDebug() << "DB 연결 실패:" << m_db.lastError().text();
+QFuture<bool> Database::connectAsync()
+{
+    return m_worker.run([this]() {
+        return m_connected || open();
+    });
+}
+
+bool Database::open()
+{
+    PROFILE_SCOPE("Database::open");
+    // 현재 스레드의 연결을 한 번 열어 접속 정보 확인
+    ConnectionPool::Lease lease = m_pool.acquire();
+    if (!lease.isValid())
         return false;
-    }
 
     qDebug() << "DB 연결 성공";
+
+    // 인덱스 마이그레이션 후 주요 쿼리의 실행 계획 확인 (실패해도 앱은 계속 동작)
+    // 마이그레이션과 EXPLAIN 은 MySQL 문법이라, 스키마를 직접 만드는 SQLite 대체 DB(벤치마크)에서는 건너뛴다
+    if (!m_epochMsTime) {
+        SchemaMigrator migrator(lease.database());
+        if (!migrator.migrate())
+            qWarning() << "스키마 마이그레이션 실패, 현재 버전:" << migrator.currentVersion();
+        migrator.verifyQueryPlans();
+    }
+
+    m_worker.start();
+    m_connected = true;
     return true;
 }
 
 void Database::disconnect()
 {
-    if (m_db.isOpen()) {
-        m_db.close();
-        QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
-    }
+    // 작업 스레드가 끝나면서 자신의 연결을 풀에 반납
+    m_worker.stop();
+    m_pool.closeAll();
+    m_connected = false;
 }
 
 Database::~Database()
@@ -47,267 +94,611 @@ Database::~Database()
     disconnect();
 }
 
+bool Database::isConnected() const
+{
+    return m_connected;
+}
+
+
+// ---------------------- 최신 값 조회 ----------------------
+// afterId 보다 큰 id 의 행만 보므로 (PK 범위 탐색) 테이블 크기와 무관하게 빠르고,
+// 새 행이 없으면 std::nullopt 를 반환한다. afterId = 0 이면 해당 집의 최신 행.
 
 // 온습도 조회
-std::optional<QPair<double, double>> Database::getLatestHomeEnv(const QString& homeId)
+std::optional<QPair<double, double>> Database::getLatestHomeEnv(const QString& homeId, qint64 afterId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT temperature, humidity FROM home_env "
-                  "ORDER BY measured_at DESC LIMIT 1");
-    // query.bindValue(":homeId", homeId);
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared("latestHomeEnv",
+                                      "SELECT temperature, humidity FROM home_env "
+                                      "WHERE home_id = :homeId AND id > :afterId "
+                                      "ORDER BY id DESC LIMIT 1");
+    if (!query)
+        return std::nullopt;
+    query->bindValue(":homeId", homeId);
+    query->bindValue(":afterId", afterId);
 
-    if (!query.exec()) {
-        qDebug() << "쿼리 실패:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "쿼리 실패:" << query->lastError().text();
         return std::nullopt;
     }
 
-    if (query.next())
-        return QPair<double, double>(query.value(0).toDouble(),
-                                     query.value(1).toDouble());
+    if (query->next())
+        return QPair<double, double>(query->value(0).toDouble(),
+                                     query->value(1).toDouble());
 
     return std::nullopt;
 }
 
 // fire_events 조회
-std::optional<QPair<QString, QString>> Database::getLatestFireStatus(const QString& homeId)
+std::optional<QPair<QString, QString>> Database::getLatestFireStatus(const QString& homeId, qint64 afterId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT fire_status, level_status FROM fire_events "
-                  "ORDER BY detected_at DESC LIMIT 1");
-    // query.bindValue(":homeId", homeId);
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared("latestFireStatus",
+                                      "SELECT fire_status, level_status FROM fire_events "
+                                      "WHERE home_id = :homeId AND id > :afterId "
+                                      "ORDER BY id DESC LIMIT 1");
+    if (!query)
+        return std::nullopt;
+    query->bindValue(":homeId", homeId);
+    query->bindValue(":afterId", afterId);
 
-    if (!query.exec()) {
-        qDebug() << "쿼리 실패:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "쿼리 실패:" << query->lastError().text();
         return std::nullopt;
     }
 
-    if (query.next())
-        return QPair<QString, QString>(query.value(0).toString(),
-                                       query.value(1).toString());
+    if (query->next())
+        return QPair<QString, QString>(query->value(0).toString(),
+                                       query->value(1).toString());
     return std::nullopt;
 }
 
 
 // 토양수분 조회
-std::optional<int> Database::getLatestSoilMoisture(const QString& homeId)
+std::optional<int> Database::getLatestSoilMoisture(const QString& homeId, qint64 afterId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT soil_moisture FROM plant_env "
-                  "ORDER BY measured_at DESC LIMIT 1");
-    // query.bindValue(":homeId", homeId);
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared("latestSoilMoisture",
+                                      "SELECT soil_moisture FROM plant_env "
+                                      "WHERE home_id = :homeId AND id > :afterId "
+                                      "ORDER BY id DESC LIMIT 1");
+    if (!query)
+        return std::nullopt;
+    query->bindValue(":homeId", homeId);
+    query->bindValue(":afterId", afterId);
 
-    if (!query.exec()) {
-        qDebug() << "쿼리 실패:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "쿼리 실패:" << query->lastError().text();
         return std::nullopt;
     }
 
-    if (query.next())
-        return query.value(0).toInt();
+    if (query->next())
+        return query->value(0).toInt();
 
     return std::nullopt;
 }
 
 // 반려동물 상태 조회
-std::optional<QString> Database::getLatestPetToilet(const QString& homeId)
+std::optional<QString> Database::getLatestPetToilet(const QString& homeId, qint64 afterId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT toilet FROM pet_status "
-                  "ORDER BY measured_at DESC LIMIT 1");
-    // query.bindValue(":homeId", homeId);
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared("latestPetToilet",
+                                      "SELECT toilet FROM pet_status "
+                                      "WHERE home_id = :homeId AND id > :afterId "
+                                      "ORDER BY id DESC LIMIT 1");
+    if (!query)
+        return std::nullopt;
+    query->bindValue(":homeId", homeId);
+    query->bindValue(":afterId", afterId);
 
-    if (!query.exec()) {
-        qDebug() << "쿼리 실패:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "쿼리 실패:" << query->lastError().text();
         return std::nullopt;
     }
 
-    if (query.next())
-        return query.value(0).toString();
+    if (query->next())
+        return query->value(0).toString();
 
     return std::nullopt;
 }
 
-// 현관문 상태
-std::optional<QString> Database::getLatestDoorStatus(const QString& homeId)
+// 대시보드 스냅샷 - 테이블별 최신 1행을 하나의 결과셋으로 묶어 조회
+std::optional<DashboardSnapshot> Database::getDashboardSnapshot(const QString& homeId)
 {
-    QSqlQuery query;
-    query.prepare("SELECT status FROM door_status "
-                  "ORDER BY measured_at DESC LIMIT 1");
-    //query.bindValue(":homeId", homeId);
+    ConnectionPool::Lease lease = m_pool.acquire();
+    // 각 행의 첫 컬럼이 출처 테이블, 값은 UNION 타입을 맞추기 위해 문자열로 변환
+    QSqlQuery* query = lease.prepared("dashboardSnapshot", R"(
+        (SELECT 'home_env' AS src, CAST(temperature AS CHAR) AS v1, CAST(humidity AS CHAR) AS v2
+           FROM home_env WHERE home_id = :homeId1 ORDER BY id DESC LIMIT 1)
+        UNION ALL
+        (SELECT 'fire_events', fire_status, level_status
+           FROM fire_events WHERE home_id = :homeId2 ORDER BY id DESC LIMIT 1)
+        UNION ALL
+        (SELECT 'plant_env', CAST(soil_moisture AS CHAR), NULL
+           FROM plant_env WHERE home_id = :homeId3 ORDER BY id DESC LIMIT 1)
+        UNION ALL
+        (SELECT 'pet_status', toilet, NULL
+           FROM pet_status WHERE home_id = :homeId4 ORDER BY id DESC LIMIT 1)
+    )");
+    if (!query)
+        return std::nullopt;
+    query->bindValue(":homeId1", homeId);
+    query->bindValue(":homeId2", homeId);
+    query->bindValue(":homeId3", homeId);
+    query->bindValue(":homeId4", homeId);
 
-    if (!query.exec()) {
-        qDebug() << "쿼리 실패:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "getDashboardSnapshot 실패:" << query->lastError().text();
         return std::nullopt;
     }
 
-    if (query.next())
-        return query.value(0).toString();
+    DashboardSnapshot snapshot;
+    while (query->next()) {
+        const QString source = query->value(0).toString();
+        if (source == "home_env") {
+            snapshot.homeEnv = QPair<double, double>(query->value(1).toDouble(),
+                                                     query->value(2).toDouble());
+        } else if (source == "fire_events") {
+            snapshot.fireStatus = QPair<QString, QString>(query->value(1).toString(),
+                                                          query->value(2).toString());
+        } else if (source == "plant_env") {
+            snapshot.soilMoisture = query->value(1).toInt();
+        } else if (source == "pet_status") {
+            snapshot.petToilet = query->value(1).toString();
+        }
+    }
 
-    return std::nullopt;
+    return snapshot;
 }
 
-// ---------------------- 집 상태 ----------------------
-// 1. 집 상태 검색 메서드 수정
-std::optional<QVector<QVector<QString>>> Database::getSearchListHome(const QString& firstDateTime, const QString& lastDateTime)
+// 테이블별 워터마크 - MAX(id) 는 PK 인덱스 끝만 읽으므로 테이블 크기와 무관
+std::optional<TableWatermarks> Database::getTableWatermarks()
 {
-    QVector<QVector<QString>> results;
-    QSqlQuery query;
-
-    // DATE() 함수를 제거하고 직접 datetime 비교로 변경
-    query.prepare(R"(
-        SELECT temperature, humidity, illumination, measured_at
-        FROM home_env
-        WHERE measured_at >= :firstDateTime
-          AND measured_at <= :lastDateTime
-        ORDER BY measured_at DESC
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared("tableWatermarks", R"(
+        SELECT (SELECT COALESCE(MAX(id), 0) FROM home_env),
+               (SELECT COALESCE(MAX(id), 0) FROM fire_events),
+               (SELECT COALESCE(MAX(id), 0) FROM plant_env),
+               (SELECT COALESCE(MAX(id), 0) FROM pet_status)
     )");
-    query.bindValue(":firstDateTime", firstDateTime);
-    query.bindValue(":lastDateTime", lastDateTime);
+    if (!query)
+        return std::nullopt;
 
-    if (!query.exec()) {
-        qDebug() << "getSearchListHome 실패:" << query.lastError().text();
+    if (!query->exec()) {
+        qDebug() << "getTableWatermarks 실패:" << query->lastError().text();
         return std::nullopt;
     }
 
-    while (query.next()) {
-        QVector<QString> row;
-        row << query.value(0).toString()  // 온도
-            << query.value(1).toString()  // 습도
-            << query.value(2).toString()  // 조도
-            << query.value(3).toString(); // 감지시간
-        results.push_back(row);
-    }
+    if (!query->next())
+        return std::nullopt;
 
-    return results;
+    TableWatermarks marks;
+    marks.homeEnv = query->value(0).toLongLong();
+    marks.fireEvents = query->value(1).toLongLong();
+    marks.plantEnv = query->value(2).toLongLong();
+    marks.petStatus = query->value(3).toLongLong();
+    return marks;
 }
 
-// 2. 화재 검색 메서드 수정
-std::optional<QVector<QVector<QString>>> Database::getSearchListFire(const QString& firstDateTime, const QString& lastDateTime)
+// ---------------------- 검색 (키셋 페이지) ----------------------
+namespace {
+
+// 시각 컬럼 변환 - SQL 에서 방언이 다른 부분은 이것뿐
+// MySQL 은 DATETIME 을 UNIX_TIMESTAMP/FROM_UNIXTIME 으로 세션 시간대 기준 변환,
+// SQLite 대체 DB(벤치마크)는 시각을 epoch ms 정수로 저장하므로 그대로 비교한다
+struct TimeSql
 {
-    QVector<QVector<QString>> results;
-    QSqlQuery query;
+    bool epochMs;
 
-    // DATE() 함수를 제거하고 직접 datetime 비교로 변경
-    query.prepare(R"(
-        SELECT fire_status, fire_level, detected_at
-        FROM fire_events
-        WHERE detected_at >= :firstDateTime
-          AND detected_at <= :lastDateTime
-        ORDER BY detected_at DESC
-    )");
-    query.bindValue(":firstDateTime", firstDateTime);
-    query.bindValue(":lastDateTime", lastDateTime);
+    // 시각 컬럼 -> epoch ms
+    QString toMs(const char* column) const
+    {
+        return epochMs ? QString(column) : QString("CAST(UNIX_TIMESTAMP(%1) * 1000 AS SIGNED)").arg(column);
+    }
 
-    if (!query.exec()) {
-        qDebug() << "getSearchListFire 실패:" << query.lastError().text();
-        return std::nullopt;
+    // epoch ms 파라미터 -> 시각 컬럼과 비교할 값
+    QString fromMs(const char* param) const
+    {
+        return epochMs ? QString(param) : QString("FROM_UNIXTIME(%1 / 1000)").arg(param);
     }
 
-    while (query.next()) {
-        QVector<QString> row;
-        row << query.value(0).toString()  // 화재상태
-            << query.value(1).toString()  // 화재수치
-            << query.value(2).toString(); // 감지시간
-        results.push_back(row);
+    // :offset 만큼 밀어서 :bucket 초 단위로 내린 구간 시작 (epoch ms)
+    QString bucketMs(const char* column) const
+    {
+        return epochMs ? QString("((%1 / 1000 + :offset1) / :bucket1 * :bucket2 - :offset2) * 1000").arg(column)
+                       : QString("(FLOOR((UNIX_TIMESTAMP(%1) + :offset1) / :bucket1) * :bucket2 - :offset2) * 1000").arg(column);
     }
+};
 
-    return results;
+// 카테고리별 조회 대상 - SELECT 는 id, 시각(epoch ms), 값 컬럼들 순서
+// aggregateColumn 은 구간 집계에 쓰는 숫자 컬럼 (없으면 집계 불가)
+struct SearchSpec
+{
+    const char* statementId;
+    const char* aggregateStatementId;
+    const char* table;
+    const char* timeColumn;
+    const char* valueColumns;
+    const char* aggregateColumn;
+};
+
+const SearchSpec& searchSpec(SearchCategory category)
+{
+    static const SearchSpec specs[] = {
+        { "searchPageHome",  "searchAggHome",  "home_env",    "measured_at", "temperature, humidity, illumination", "temperature" },   // 온도, 습도, 조도
+        { "searchPageFire",  "searchAggFire",  "fire_events", "detected_at", "fire_status, fire_level",             "fire_level" },    // 화재상태, 화재수치
+        { "searchPageGas",   "searchAggGas",   "fire_events", "detected_at", "level_status, level",                 "level" },         // 가스누출상태, 가스수치
+        { "searchPagePlant", "searchAggPlant", "plant_env",   "measured_at", "soil_moisture",                       "soil_moisture" }, // 토양습도
+        { "searchPagePet",   nullptr,          "pet_status",  "measured_at", "food, water, toilet",                 nullptr },         // 급식, 급수, 배변
+    };
+    return specs[static_cast<int>(category)];
 }
 
-// 3. 가스 검색 메서드 수정
-std::optional<QVector<QVector<QString>>> Database::getSearchListGas(const QString& firstDateTime, const QString& lastDateTime)
+// 현재 행의 값 컬럼(2번부터)을 카테고리별 컬럼 배열에 추가
+void appendRow(HomeEnvColumns& columns, qint64 ts, const QSqlQuery& query)
 {
-    QVector<QVector<QString>> results;
-    QSqlQuery query;
+    columns.ts.append(ts);
+    columns.temperature.append(query.value(2).toFloat());
+    columns.humidity.append(query.value(3).toFloat());
+    columns.illumination.append(query.value(4).toInt());
+}
 
-    // DATE() 함수를 제거하고 직접 datetime 비교로 변경
-    query.prepare(R"(
-        SELECT level_status, level, detected_at
-        FROM fire_events
-        WHERE detected_at >= :firstDateTime
-          AND detected_at <= :lastDateTime
-        ORDER BY detected_at DESC
-    )");
-    query.bindValue(":firstDateTime", firstDateTime);
-    query.bindValue(":lastDateTime", lastDateTime);
+void appendRow(EventColumns& columns, qint64 ts, const QSqlQuery& query)
+{
+    columns.ts.append(ts);
+    columns.status.append(columns.statusNames.intern(query.value(2).toString()));
+    columns.level.append(query.value(3).toFloat());
+}
+
+void appendRow(PlantColumns& columns, qint64 ts, const QSqlQuery& query)
+{
+    columns.ts.append(ts);
+    columns.soilMoisture.append(query.value(2).toInt());
+}
 
-    if (!query.exec()) {
-        qDebug() << "getSearchListGas 실패:" << query.lastError().text();
+void appendRow(PetColumns& columns, qint64 ts, const QSqlQuery& query)
+{
+    columns.ts.append(ts);
+    columns.food.append(columns.names.intern(query.value(2).toString()));
+    columns.water.append(columns.names.intern(query.value(3).toString()));
+    columns.toilet.append(columns.names.intern(query.value(4).toString()));
+}
+
+SearchColumns emptyColumns(SearchCategory category)
+{
+    switch (category) {
+    case SearchCategory::HomeEnv: return HomeEnvColumns();
+    case SearchCategory::Fire:
+    case SearchCategory::Gas:     return EventColumns();
+    case SearchCategory::Plant:   return PlantColumns();
+    case SearchCategory::Pet:     return PetColumns();
+    }
+    return HomeEnvColumns();
+}
+
+} // namespace
+
+// (시각, id) 내림차순 키셋 페이지 - OFFSET 없이 커서 바로 뒤부터 limit 개만 읽는다
+// 커서가 없으면 lastMs 부터 시작. limit + 1 개를 읽어 다음 페이지 존재 여부를 판단
+// 시각은 서버에서 UNIX_TIMESTAMP/FROM_UNIXTIME 으로 변환해 DB 세션 시간대 기준으로 왕복이 일치한다
+std::optional<SearchPage> Database::getSearchPage(SearchCategory category,
+                                                  const QString& homeId,
+                                                  qint64 firstMs,
+                                                  qint64 lastMs,
+                                                  const SearchCursor& after,
+                                                  int limit)
+{
+    const SearchSpec& spec = searchSpec(category);
+    const TimeSql time { m_epochMsTime };
+    const QString sql = QString(R"(
+        SELECT id, %4, %1
+        FROM %3
+        WHERE home_id = :homeId
+          AND %2 >= %5
+          AND %2 <= %6
+          AND (%2 < %7
+               OR (%2 = %8 AND id < :cursorId))
+        ORDER BY %2 DESC, id DESC
+        LIMIT :limit
+    )").arg(spec.valueColumns, spec.timeColumn, spec.table, time.toMs(spec.timeColumn),
+            time.fromMs(":firstMs"), time.fromMs(":cursorMs1"), time.fromMs(":cursorMs2"), time.fromMs(":cursorMs3"));
+
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared(spec.statementId, sql);
+    if (!query)
+        return std::nullopt;
+
+    // 첫 페이지는 lastMs 와 같은 시각의 행도 모두 포함되도록 id 상한을 최대로 둔다
+    const qint64 cursorMs = after.isValid() ? after.timeMs : lastMs;
+    const qint64 cursorId = after.isValid() ? after.id : std::numeric_limits<qint64>::max();
+    query->bindValue(":homeId", homeId);
+    query->bindValue(":firstMs", firstMs);
+    query->bindValue(":cursorMs1", cursorMs);
+    query->bindValue(":cursorMs2", cursorMs);
+    query->bindValue(":cursorMs3", cursorMs);
+    query->bindValue(":cursorId", cursorId);
+    query->bindValue(":limit", limit + 1);
+
+    if (!query->exec()) {
+        qDebug() << "getSearchPage 실패:" << spec.table << query->lastError().text();
         return std::nullopt;
     }
 
-    while (query.next()) {
-        QVector<QString> row;
-        row << query.value(0).toString()  // 가스누출상태
-            << query.value(1).toString()  // 가스수치
-            << query.value(2).toString(); // 감지시간
-        results.push_back(row);
+    SearchPage page;
+    page.category = category;
+    page.columns = emptyColumns(category);
+    std::visit([limit](auto& columns) { columns.reserve(limit); }, page.columns);
+
+    int rows = 0;
+    while (query->next()) {
+        if (rows == limit) {
+            page.hasMore = true;
+            break;
+        }
+
+        const qint64 ts = query->value(1).toLongLong();
+        std::visit([&](auto& columns) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(columns)>, AggregateColumns>)
+                appendRow(columns, ts, *query);
+        }, page.columns);
+        ++rows;
+
+        page.next.id = query->value(0).toLongLong();
+        page.next.timeMs = ts;
     }
 
-    return results;
+    return page;
 }
 
-// 4. 식물 검색 메서드 수정
-std::optional<QVector<QVector<QString>>> Database::getSearchListPlant(const QString& firstDateTime, const QString& lastDateTime)
+// ---------------------- 검색 (구간 집계) ----------------------
+SearchBucket Database::autoBucket(qint64 rangeMs)
 {
-    QVector<QVector<QString>> results;
-    QSqlQuery query;
+    // 결과가 대략 수천 행 이하가 되도록 범위 길이에 맞춰 구간 크기 선택
+    const qint64 hourMs = 60LL * 60 * 1000;
+    if (rangeMs <= 6 * hourMs)
+        return SearchBucket::Raw;
+    if (rangeMs <= 48 * hourMs)
+        return SearchBucket::Minute;
+    if (rangeMs <= 90 * 24 * hourMs)
+        return SearchBucket::Hour;
+    return SearchBucket::Day;
+}
 
-    // DATE() 함수를 제거하고 직접 datetime 비교로 변경
-    query.prepare(R"(
-        SELECT soil_moisture, measured_at
-        FROM plant_env
-        WHERE measured_at >= :firstDateTime
-          AND measured_at <= :lastDateTime
-        ORDER BY measured_at DESC
-    )");
-    query.bindValue(":firstDateTime", firstDateTime);
-    query.bindValue(":lastDateTime", lastDateTime);
+bool Database::supportsAggregation(SearchCategory category)
+{
+    return searchSpec(category).aggregateColumn != nullptr;
+}
 
-    if (!query.exec()) {
-        qDebug() << "getSearchListPlant 실패:" << query.lastError().text();
+// 시각을 구간 크기로 내림해 GROUP BY - 원본 행 대신 구간별 min/avg/max/count 만 전송
+// 일 단위 구간이 로컬 자정에 맞도록 클라이언트 UTC 오프셋만큼 밀어서 자른다 (오프셋이 바뀌는 시점마다 나눠 조회)
+std::optional<SearchPage> Database::getSearchAggregate(SearchCategory category,
+                                                       const QString& homeId,
+                                                       qint64 firstMs,
+                                                       qint64 lastMs,
+                                                       SearchBucket bucket)
+{
+    const SearchSpec& spec = searchSpec(category);
+    if (!spec.aggregateColumn || bucket == SearchBucket::Raw) {
+        qWarning() << "getSearchAggregate: 집계할 수 없는 조회" << spec.table;
         return std::nullopt;
     }
 
-    while (query.next()) {
-        QVector<QString> row;
-        row << query.value(0).toString()  // 토양습도
-            << query.value(1).toString(); // 감지시간
-        results.push_back(row);
+    const TimeSql time { m_epochMsTime };
+    const QString sql = QString(R"(
+        SELECT %4 AS bucket_ms,
+               MIN(%1), AVG(%1), MAX(%1), COUNT(*)
+        FROM %3
+        WHERE home_id = :homeId
+          AND %2 >= %5
+          AND %2 <= %6
+        GROUP BY bucket_ms
+        ORDER BY bucket_ms DESC
+    )").arg(spec.aggregateColumn, spec.timeColumn, spec.table, time.bucketMs(spec.timeColumn),
+            time.fromMs(":firstMs"), time.fromMs(":lastMs"));
+
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared(spec.aggregateStatementId, sql);
+    if (!query)
+        return std::nullopt;
+
+    // 일광 절약 시간 전환이 있으면 범위 안에서 UTC 오프셋이 바뀌므로, 전환 시점마다 범위를 나눠
+    // 조각마다 그 조각의 오프셋으로 자른다
+    QVector<QPair<qint64, qint64>> segments;
+    qint64 segmentFirst = firstMs;
+    const QTimeZone zone = QTimeZone::systemTimeZone();
+    const auto transitions = zone.transitions(QDateTime::fromMSecsSinceEpoch(firstMs),
+                                              QDateTime::fromMSecsSinceEpoch(lastMs));
+    for (const QTimeZone::OffsetData& transition : transitions) {
+        const qint64 atMs = transition.atUtc.toMSecsSinceEpoch();
+        if (atMs <= segmentFirst || atMs > lastMs)
+            continue;
+        segments.append({ segmentFirst, atMs - 1 });
+        segmentFirst = atMs;
+    }
+    segments.append({ segmentFirst, lastMs });
+
+    // 로컬 구간 시작 -> 합계. 전환이 있는 날은 양쪽 조각에서 같은 날의 행이 나오므로 합친다
+    struct Bucket
+    {
+        float min;
+        float max;
+        double sum;
+        int count;
+    };
+    QMap<qint64, Bucket> buckets;
+
+    const int bucketSeconds = static_cast<int>(bucket);
+    for (const auto& segment : segments) {
+        const int offsetSeconds = QDateTime::fromMSecsSinceEpoch(segment.first).offsetFromUtc();
+        query->bindValue(":offset1", offsetSeconds);
+        query->bindValue(":offset2", offsetSeconds);
+        query->bindValue(":bucket1", bucketSeconds);
+        query->bindValue(":bucket2", bucketSeconds);
+        query->bindValue(":homeId", homeId);
+        query->bindValue(":firstMs", segment.first);
+        query->bindValue(":lastMs", segment.second);
+
+        if (!query->exec()) {
+            qDebug() << "getSearchAggregate 실패:" << spec.table << query->lastError().text();
+            return std::nullopt;
+        }
+
+        while (query->next()) {
+            qint64 startMs = query->value(0).toLongLong();
+            if (bucket == SearchBucket::Day) {
+                // 조각의 오프셋으로 자른 자정 -> 그 날짜의 실제 로컬 자정 (전환일은 23/25시간)
+                const QDate day = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::fromSecondsAheadOfUtc(offsetSeconds)).date();
+                startMs = day.startOfDay().toMSecsSinceEpoch();
+            }
+
+            const float min = query->value(1).toFloat();
+            const float max = query->value(3).toFloat();
+            const int count = query->value(4).toInt();
+            const double sum = query->value(2).toDouble() * count;
+            auto it = buckets.find(startMs);
+            if (it == buckets.end()) {
+                buckets.insert(startMs, { min, max, sum, count });
+            } else {
+                it->min = qMin(it->min, min);
+                it->max = qMax(it->max, max);
+                it->sum += sum;
+                it->count += count;
+            }
+        }
     }
 
-    return results;
+    // 최신 구간부터
+    AggregateColumns columns;
+    columns.bucketMs = qint64(bucketSeconds) * 1000;
+    columns.reserve(int(buckets.size()));
+    for (auto it = buckets.constEnd(); it != buckets.constBegin();) {
+        --it;
+        columns.ts.append(it.key());
+        columns.min.append(it->min);
+        columns.avg.append(it->count > 0 ? float(it->sum / it->count) : 0.0f);
+        columns.max.append(it->max);
+        columns.count.append(it->count);
+    }
+
+    SearchPage page;
+    page.category = category;
+    page.columns = columns;
+    return page;
 }
 
-// 5. 펫 검색 메서드 수정
-std::optional<QVector<QVector<QString>>> Database::getSearchListPet(const QString& firstDateTime, const QString& lastDateTime)
+// ---------------------- 검색 (캐시 무효화) ----------------------
+// id > afterId 인 새 행 중 가장 오래된 시각 - id 는 PK 범위로 새 행만 읽는다
+// 새 행이 없으면 qint64 최대값 (무효화할 구간 없음)
+std::optional<qint64> Database::getOldestTimeAfterId(SearchCategory category, const QString& homeId, qint64 afterId)
 {
-    QVector<QVector<QString>> results;
-    QSqlQuery query;
-
-    // DATE() 함수를 제거하고 직접 datetime 비교로 변경
-    query.prepare(R"(
-        SELECT food, water, toilet, measured_at
-        FROM pet_status
-        WHERE measured_at >= :firstDateTime
-          AND measured_at <= :lastDateTime
-        ORDER BY measured_at DESC
-    )");
-    query.bindValue(":firstDateTime", firstDateTime);
-    query.bindValue(":lastDateTime", lastDateTime);
+    const SearchSpec& spec = searchSpec(category);
+    const TimeSql time { m_epochMsTime };
+    const QString sql = QString(R"(
+        SELECT MIN(%1)
+        FROM %2
+        WHERE id > :afterId
+          AND home_id = :homeId
+    )").arg(time.toMs(spec.timeColumn), spec.table);
+
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared(QString("oldestAfterId:") + spec.table, sql);
+    if (!query)
+        return std::nullopt;
 
-    if (!query.exec()) {
-        qDebug() << "getSearchListPet 실패:" << query.lastError().text();
+    query->bindValue(":afterId", afterId);
+    query->bindValue(":homeId", homeId);
+    if (!query->exec()) {
+        qDebug() << "getOldestTimeAfterId 실패:" << spec.table << query->lastError().text();
         return std::nullopt;
     }
 
-    while (query.next()) {
-        QVector<QString> row;
-        row << query.value(0).toString()  // 급식
-            << query.value(1).toString()  // 급수
-            << query.value(2).toString()  // 배변
-            << query.value(3).toString(); // 감지시간
-        results.push_back(row);
+    if (!query->next() || query->value(0).isNull())
+        return std::numeric_limits<qint64>::max();
+    return query->value(0).toLongLong();
+}
+
+// ---------------------- 얼굴 등록 ----------------------
+bool Database::insertFaceImage(int userId, const QString& userName, const QByteArray& pngData, QString* errorText)
+{
+    ConnectionPool::Lease lease = m_pool.acquire();
+    QSqlQuery* query = lease.prepared("insertFaceImage",
+                                      "INSERT INTO face_images (user_id, user_name, face_data) VALUES (?, ?, ?)");
+    if (!query) {
+        if (errorText) *errorText = "DB 연결 실패";
+        return false;
+    }
+    // 재사용되는 문장이므로 위치를 지정해 다시 바인딩
+    query->bindValue(0, userId);
+    query->bindValue(1, userName);
+    query->bindValue(2, pngData);
+
+    if (!query->exec()) {
+        qWarning() << "INSERT failed:" << query->lastError().text();
+        if (errorText) *errorText = query->lastError().text();
+        return false;
     }
+    return true;
+}
 
-    return results;
+// ---------------------- 비동기 버전 ----------------------
+QFuture<std::optional<QPair<double, double>>> Database::getLatestHomeEnvAsync(const QString& homeId, qint64 afterId)
+{
+    return m_worker.run([this, homeId, afterId]() { return getLatestHomeEnv(homeId, afterId); });
+}
+
+QFuture<std::optional<QPair<QString, QString>>> Database::getLatestFireStatusAsync(const QString& homeId, qint64 afterId)
+{
+    return m_worker.run([this, homeId, afterId]() { return getLatestFireStatus(homeId, afterId); });
+}
+
+QFuture<std::optional<int>> Database::getLatestSoilMoistureAsync(const QString& homeId, qint64 afterId)
+{
+    return m_worker.run([this, homeId, afterId]() { return getLatestSoilMoisture(homeId, afterId); });
+}
+
+QFuture<std::optional<QString>> Database::getLatestPetToiletAsync(const QString& homeId, qint64 afterId)
+{
+    return m_worker.run([this, homeId, afterId]() { return getLatestPetToilet(homeId, afterId); });
+}
+
+QFuture<std::optional<DashboardSnapshot>> Database::getDashboardSnapshotAsync(const QString& homeId)
+{
+    return m_worker.run([this, homeId]() { return getDashboardSnapshot(homeId); });
+}
+
+QFuture<std::optional<TableWatermarks>> Database::getTableWatermarksAsync()
+{
+    return m_worker.run([this]() { return getTableWatermarks(); });
+}
+
+QFuture<std::optional<SearchPage>> Database::getSearchAggregateAsync(SearchCategory category,
+                                                                  const QString& homeId,
+                                                                  qint64 firstMs,
+                                                                  qint64 lastMs,
+                                                                  SearchBucket bucket)
+{
+    return m_worker.run([this, category, homeId, firstMs, lastMs, bucket]() {
+        return getSearchAggregate(category, homeId, firstMs, lastMs, bucket);
+    });
+}
+
+QFuture<std::optional<qint64>> Database::getOldestTimeAfterIdAsync(SearchCategory category,
+                                                                  const QString& homeId,
+                                                                  qint64 afterId)
+{
+    return m_worker.run([this, category, homeId, afterId]() {
+        return getOldestTimeAfterId(category, homeId, afterId);
+    });
+}
+
+QFuture<std::optional<SearchPage>> Database::getSearchPageAsync(SearchCategory category,
+                                                             const QString& homeId,
+                                                             qint64 firstMs,
+                                                             qint64 lastMs,
+                                                             const SearchCursor& after,
+                                                             int limit)
+{
+    return m_worker.run([this, category, homeId, firstMs, lastMs, after, limit]() {
+        return getSearchPage(category, homeId, firstMs, lastMs, after, limit);
+    });
 }
@@ -1,39 +1,159 @@
-// database.h에서 수정할 부분 - 메서드 시그니처 변경
-
 #ifndef DATABASE_H
 #define DATABASE_H
 
 #include <QString>
-#include <QSqlDatabase>
 #include <QVariant>
 #include <QVector>
+#include <QFuture>
 #include <optional>
+#include <atomic>
+#include "dbworker.h"
+#include "connectionpool.h"
+#include "searchcolumns.h"
+
+// 대시보드 카드에 표시할 최신 값 묶음 (한 번의 쿼리로 조회)
+struct DashboardSnapshot
+{
+    std::optional<QPair<double, double>> homeEnv;       // 온도, 습도
+    std::optional<QPair<QString, QString>> fireStatus;  // 화재상태, 가스상태
+    std::optional<int> soilMoisture;                    // 토양수분
+    std::optional<QString> petToilet;                   // 배변 상태
+};
+
+// 테이블별 마지막 행 id (변경 감지용 워터마크)
+struct TableWatermarks
+{
+    qint64 homeEnv = 0;
+    qint64 fireEvents = 0;
+    qint64 plantEnv = 0;
+    qint64 petStatus = 0;
+};
+
+// 검색 카테고리 (Search 화면 콤보박스 순서와 같음)
+enum class SearchCategory
+{
+    HomeEnv,
+    Fire,
+    Gas,
+    Plant,
+    Pet
+};
+
+// 검색 집계 구간 크기 (초). Raw 는 집계 없이 원본 행
+enum class SearchBucket
+{
+    Raw = 0,
+    Minute = 60,
+    Hour = 60 * 60,
+    Day = 24 * 60 * 60
+};
+
+// 키셋 페이지 커서 - 마지막으로 받은 행의 (시각 epoch ms, id). 기본값은 "처음부터"
+struct SearchCursor
+{
+    qint64 timeMs = 0;
+    qint64 id = 0;
+
+    bool isValid() const { return id > 0; }
+};
+
+// 검색 결과 한 페이지 - category 에 맞는 컬럼 배열이 columns 에 들어 있다
+// (온도: HomeEnvColumns, 화재/가스: EventColumns, 식물: PlantColumns, 펫: PetColumns,
+//  구간 집계 결과는 카테고리와 무관하게 AggregateColumns)
+struct SearchPage
+{
+    SearchCategory category = SearchCategory::HomeEnv;
+    SearchColumns columns;
+    SearchCursor next;      // 다음 페이지 요청 시 after 로 넘길 커서
+    bool hasMore = false;
+};
 
 class Database
 {
 public:
     static Database& instance();
 
+    // 접속 정보만 설정 (네트워크 접속 없음)
+    void configure(const QString& host,
+                   const QString& dbName,
+                   const QString& user,
+                   const QString& password,
+                   int port = 3306);
+    // 드라이버까지 직접 지정 (벤치마크의 SQLite 대체 DB 등)
+    // QSQLITE 는 시각 컬럼을 DATETIME 대신 epoch ms 정수로 저장한 스키마로 간주한다
+    void configure(const ConnectionPool::Config& config);
+
     bool connect(const QString& host,
                  const QString& dbName,
                  const QString& user,
                  const QString& password,
                  int port = 3306);
 
+    // configure() 로 설정한 정보로 DB 작업 스레드에서 연결 (GUI 스레드는 기다리지 않음)
+    // 스키마 마이그레이션/실행 계획 확인도 작업 스레드에서 끝낸 뒤 결과를 전달
+    QFuture<bool> connectAsync();
+
     void disconnect();
+    bool isConnected() const;
+
+    // SELECT 쿼리 메서드들 - afterId 이후 새 행이 없으면 std::nullopt
+    std::optional<QPair<double, double>> getLatestHomeEnv(const QString& homeId, qint64 afterId = 0);
+    std::optional<QPair<QString, QString>> getLatestFireStatus(const QString& homeId, qint64 afterId = 0);
+    std::optional<int> getLatestSoilMoisture(const QString& homeId, qint64 afterId = 0);
+    std::optional<QString> getLatestPetToilet(const QString& homeId, qint64 afterId = 0);
 
-    // SELECT 쿼리 메서드들
-    std::optional<QPair<double, double>> getLatestHomeEnv(const QString& homeId);
-    std::optional<QPair<QString, QString>> getLatestFireStatus(const QString& homeId);
-    std::optional<int> getLatestSoilMoisture(const QString& homeId);
-    std::optional<QString> getLatestPetToilet(const QString& homeId);
-    std::optional<QString> getLatestDoorStatus(const QString& homeId);
+    // 위 getLatest* 4개를 UNION ALL 한 번의 왕복으로 조회
+    std::optional<DashboardSnapshot> getDashboardSnapshot(const QString& homeId);
 
-    std::optional<QVector<QVector<QString>>> getSearchListHome(const QString& firstDateTime, const QString& lastDateTime);
-    std::optional<QVector<QVector<QString>>> getSearchListFire(const QString& firstDateTime, const QString& lastDateTime);
-    std::optional<QVector<QVector<QString>>> getSearchListGas(const QString& firstDateTime, const QString& lastDateTime);
-    std::optional<QVector<QVector<QString>>> getSearchListPlant(const QString& firstDateTime, const QString& lastDateTime);
-    std::optional<QVector<QVector<QString>>> getSearchListPet(const QString& firstDateTime, const QString& lastDateTime);
+    // 센서 테이블별 MAX(id) - ChangeFeed 가 새 행 도착 여부를 판단하는 데 사용
+    std::optional<TableWatermarks> getTableWatermarks();
+
+    // 검색 결과 한 페이지 (after 커서 다음부터 최대 limit 행, 최신순)
+    std::optional<SearchPage> getSearchPage(SearchCategory category,
+                                            const QString& homeId,
+                                            qint64 firstMs,
+                                            qint64 lastMs,
+                                            const SearchCursor& after = SearchCursor(),
+                                            int limit = 500);
+
+    // 구간 집계 (min/avg/max) - 집계 결과는 한 페이지로 모두 반환
+    std::optional<SearchPage> getSearchAggregate(SearchCategory category,
+                                                 const QString& homeId,
+                                                 qint64 firstMs,
+                                                 qint64 lastMs,
+                                                 SearchBucket bucket);
+    static SearchBucket autoBucket(qint64 rangeMs);         // 범위 길이에 맞는 구간 크기
+    static bool supportsAggregation(SearchCategory category);  // 펫은 숫자 값이 없어 집계 불가
+
+    // 카테고리 테이블에서 id > afterId 인 새 행의 가장 오래된 시각 (epoch ms) - 검색 캐시 부분 무효화용
+    // 새 행이 없으면 qint64 최대값
+    std::optional<qint64> getOldestTimeAfterId(SearchCategory category, const QString& homeId, qint64 afterId);
+
+    // 얼굴 등록 이미지 1장 저장 (PNG 인코딩된 데이터)
+    bool insertFaceImage(int userId, const QString& userName, const QByteArray& pngData, QString* errorText = nullptr);
+
+    // 비동기 버전 - DB 작업 스레드에서 실행되고 결과는 QFuture로 전달
+    QFuture<std::optional<QPair<double, double>>> getLatestHomeEnvAsync(const QString& homeId, qint64 afterId = 0);
+    QFuture<std::optional<QPair<QString, QString>>> getLatestFireStatusAsync(const QString& homeId, qint64 afterId = 0);
+    QFuture<std::optional<int>> getLatestSoilMoistureAsync(const QString& homeId, qint64 afterId = 0);
+    QFuture<std::optional<QString>> getLatestPetToiletAsync(const QString& homeId, qint64 afterId = 0);
+    QFuture<std::optional<DashboardSnapshot>> getDashboardSnapshotAsync(const QString& homeId);
+    QFuture<std::optional<TableWatermarks>> getTableWatermarksAsync();
+
+    QFuture<std::optional<SearchPage>> getSearchPageAsync(SearchCategory category,
+                                                          const QString& homeId,
+                                                          qint64 firstMs,
+                                                          qint64 lastMs,
+                                                          const SearchCursor& after = SearchCursor(),
+                                                          int limit = 500);
+    QFuture<std::optional<SearchPage>> getSearchAggregateAsync(SearchCategory category,
+                                                               const QString& homeId,
+                                                               qint64 firstMs,
+                                                               qint64 lastMs,
+                                                               SearchBucket bucket);
+    QFuture<std::optional<qint64>> getOldestTimeAfterIdAsync(SearchCategory category,
+                                                             const QString& homeId,
+                                                             qint64 afterId);
 
 private:
     Database() = default;
@@ -42,7 +162,12 @@ private:
     Database(const Database&) = delete;
     Database& operator=(const Database&) = delete;
 
-    QSqlDatabase m_db;
+    bool open();  // 현재 스레드에서 연결 확인 + 마이그레이션
+
+    ConnectionPool m_pool;
+    DbWorker m_worker;
+    bool m_epochMsTime = false;  // 시각 컬럼이 epoch ms 정수 (QSQLITE)
+    std::atomic<bool> m_connected { false };  // 작업 스레드에서 설정, GUI 스레드에서 읽음
 };
 
 #endif // DATABASE_H
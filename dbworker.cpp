@@ -0,0 +1,35 @@
+#include "dbworker.h"
+#include <QDebug>
+
+DbWorker::DbWorker()
+    : m_context(new QObject)
+{
+    m_thread.setObjectName("DbWorker");
+    m_context->moveToThread(&m_thread);
+}
+
+DbWorker::~DbWorker()
+{
+    stop();
+    delete m_context;
+}
+
+void DbWorker::start()
+{
+    if (!m_thread.isRunning())
+        m_thread.start();
+}
+
+void DbWorker::stop()
+{
+    if (m_thread.isRunning()) {
+        m_thread.quit();
+        m_thread.wait();
+    }
+}
+
+bool DbWorker::isRunning() const
+{
+    return m_thread.isRunning();
+}
+
@@ -0,0 +1,51 @@
+#ifndef DBWORKER_H
+#define DBWORKER_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QPromise>
+#include <memory>
+#include <type_traits>
+
+// DB 전용 작업 스레드
+// - GUI 스레드가 MySQL 네트워크 왕복을 기다리지 않도록 쿼리를 이 스레드에서 실행
+// - 결과는 QFuture로 돌려주며, 호출 측은 QFuture::then(context, ...)으로 GUI 스레드에서 받는다
+class DbWorker
+{
+public:
+    DbWorker();
+    ~DbWorker();
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    // fn 을 작업 스레드에서 실행하고 그 반환값을 QFuture로 전달
+    template <typename Fn>
+    auto run(Fn fn) -> QFuture<std::invoke_result_t<Fn>>
+    {
+        using Result = std::invoke_result_t<Fn>;
+
+        auto promise = std::make_shared<QPromise<Result>>();
+        QFuture<Result> future = promise->future();
+        promise->start();
+
+        start();
+        QMetaObject::invokeMethod(m_context, [promise, fn]() mutable {
+            promise->addResult(fn());
+            promise->finish();
+        }, Qt::QueuedConnection);
+
+        return future;
+    }
+
+private:
+    DbWorker(const DbWorker&) = delete;
+    DbWorker& operator=(const DbWorker&) = delete;
+
+    QThread m_thread;
+    QObject* m_context;   // 작업 스레드에 속한 이벤트 수신용 객체
+};
+
+#endif // DBWORKER_H
@@ -0,0 +1,354 @@
+#include "loadserver.h"
+#include "protocol.h"
+#include <QFile>
+#include <QDateTime>
+#include <QTextStream>
+#include <algorithm>
+
+namespace {
+
+QTextStream& out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+// 느린 클라이언트에게 무한정 쌓지 않도록 소켓 송신 대기량이 이보다 크면 이번 틱은 건너뜀
+const qint64 kMaxWriteBacklog = 8 * 1024 * 1024;
+
+qint64 percentile(QVector<qint64> values, double p)
+{
+    if (values.isEmpty())
+        return 0;
+    const int index = qMin(values.size() - 1, int(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+} // namespace
+
+LoadServer::LoadServer(const Config& config, QObject *parent)
+    : QObject(parent)
+    , m_config(config)
+    , m_client(nullptr)
+    , m_binary(false)
+    , m_random(QRandomGenerator::securelySeeded())
+    , m_sent(0)
+    , m_plant(50)
+    , m_gas(100)
+    , m_fire(800)
+    , m_replayIndex(0)
+    , m_replayOffsetMs(0)
+    , m_nextPing(1)
+    , m_lastProcessed(0)
+    , m_lastGap(0)
+    , m_lastCoalesced(-1)
+    , m_reportSent(0)
+{
+    m_config.burst = qMax(1, m_config.burst);
+
+    connect(&m_server, &QTcpServer::newConnection, this, &LoadServer::onNewConnection);
+
+    m_tickTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_tickTimer, &QTimer::timeout, this, &LoadServer::onTick);
+    connect(&m_pingTimer, &QTimer::timeout, this, &LoadServer::sendPing);
+    connect(&m_reportTimer, &QTimer::timeout, this, &LoadServer::report);
+}
+
+bool LoadServer::start()
+{
+    if (!m_config.replayPath.isEmpty() && !loadReplay())
+        return false;
+
+    if (!m_server.listen(QHostAddress::LocalHost, m_config.port)) {
+        out() << "listen 실패: " << m_server.errorString() << Qt::endl;
+        return false;
+    }
+    out() << "127.0.0.1:" << m_config.port << " 에서 대시보드 연결 대기 중 ("
+          << (m_replay.isEmpty() ? QString("합성 %1 msg/s, burst %2").arg(m_config.rate).arg(m_config.burst)
+                                 : QString("재생 %1개").arg(m_replay.size()))
+          << ")" << Qt::endl;
+    return true;
+}
+
+bool LoadServer::loadReplay()
+{
+    // 트레이스 형식: 한 줄에 "<시작 기준 ms> <메시지>", # 으로 시작하면 주석
+    QFile file(m_config.replayPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        out() << "트레이스 열기 실패: " << m_config.replayPath << " " << file.errorString() << Qt::endl;
+        return false;
+    }
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        const int space = line.indexOf(' ');
+        bool ok = false;
+        const qint64 offsetMs = space > 0 ? line.left(space).toLongLong(&ok) : 0;
+        if (!ok) {
+            out() << "트레이스 형식 오류, 건너뜀: " << line << Qt::endl;
+            continue;
+        }
+        m_replay.append({ offsetMs, line.mid(space + 1).trimmed() });
+    }
+
+    std::stable_sort(m_replay.begin(), m_replay.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (m_replay.isEmpty()) {
+        out() << "트레이스가 비어 있음: " << m_config.replayPath << Qt::endl;
+        return false;
+    }
+    return true;
+}
+
+void LoadServer::onNewConnection()
+{
+    QTcpSocket *socket = m_server.nextPendingConnection();
+    if (m_client) {
+        // 대시보드는 하나만 측정
+        socket->disconnectFromHost();
+        socket->deleteLater();
+        return;
+    }
+
+    m_client = socket;
+    m_binary = false;
+    m_readBuffer.clear();
+    m_client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    connect(m_client, &QTcpSocket::readyRead, this, &LoadServer::onReadyRead);
+    connect(m_client, &QTcpSocket::disconnected, this, &LoadServer::onDisconnected);
+
+    out() << "대시보드 연결됨: " << m_client->peerAddress().toString() << Qt::endl;
+    m_clock.start();
+    m_tickTimer.start(1);
+    m_pingTimer.start(m_config.pingIntervalMs);
+    m_reportTimer.start(1000);
+}
+
+void LoadServer::onDisconnected()
+{
+    out() << "대시보드 연결 끊김" << Qt::endl;
+    m_tickTimer.stop();
+    m_pingTimer.stop();
+    m_reportTimer.stop();
+    printSummary("종료 (연결 끊김)");
+    m_client->deleteLater();
+    m_client = nullptr;
+    emit finished();
+}
+
+void LoadServer::sendLine(const QByteArray& line)
+{
+    if (m_binary) {
+        m_client->write(Protocol::encodeMessage(line));
+        return;
+    }
+    m_client->write(line);
+    if (m_config.newline)
+        m_client->write("\n", 1);
+}
+
+QByteArray LoadServer::synthesize()
+{
+    // 종류 비율: 식물 30%, 가스 30%, 화재 20%, 펫 20%
+    const int kind = m_random.bounded(10);
+    if (kind < 3) {
+        m_plant = qBound(0, m_plant + m_random.bounded(-1, 2), 100);
+        return "PLANT:" + QByteArray::number(m_plant);
+    }
+    // 가스/화재는 대시보드 기준(가스 1000 이상, 화재 100 미만이 위험)으로 평소엔 정상 범위를 돌고
+    // 가끔(1%) 위험 값을 한 번 섞어 경보 경로도 부하를 받도록 한다
+    if (kind < 6) {
+        m_gas = qBound(0, m_gas + m_random.bounded(-10, 11), 999);
+        const int gas = m_random.bounded(100) == 0 ? m_random.bounded(1000, 1500) : m_gas;
+        return "GAS:" + QByteArray::number(gas);
+    }
+    if (kind < 8) {
+        m_fire = qBound(100, m_fire + m_random.bounded(-20, 21), 1023);
+        const int fire = m_random.bounded(100) == 0 ? m_random.bounded(0, 100) : m_fire;
+        return "FIRE:" + QByteArray::number(fire);
+    }
+    return m_random.bounded(20) == 0 ? "PET:POOP" : "PET:CLEAN";
+}
+
+void LoadServer::onTick()
+{
+    if (!m_client)
+        return;
+
+    const qint64 elapsedMs = m_clock.elapsed();
+    if (m_config.durationSec > 0 && elapsedMs >= m_config.durationSec * 1000LL) {
+        // 보내기를 멈추고 마지막 PONG 을 잠시 기다린 뒤 요약
+        m_tickTimer.stop();
+        m_pingTimer.stop();
+        sendPing();
+        QTimer::singleShot(1000, this, [this]() {
+            m_reportTimer.stop();
+            printSummary("종료");
+            emit finished();
+        });
+        return;
+    }
+
+    if (m_client->bytesToWrite() > kMaxWriteBacklog)
+        return;
+
+    if (!m_replay.isEmpty()) {
+        while (m_replayIndex < m_replay.size()
+               && m_replay[m_replayIndex].first + m_replayOffsetMs <= elapsedMs) {
+            sendLine(m_replay[m_replayIndex].second);
+            ++m_replayIndex;
+            ++m_sent;
+        }
+        if (m_replayIndex == m_replay.size() && m_config.loop) {
+            m_replayOffsetMs += m_replay.last().first + 1;
+            m_replayIndex = 0;
+        }
+        return;
+    }
+
+    // 지금까지 보냈어야 할 수를 burst 단위로 내림 - burst 개가 모일 때마다 한꺼번에 전송
+    qint64 due = qint64(m_config.rate * elapsedMs / 1000.0);
+    due -= due % m_config.burst;
+    while (m_sent < due) {
+        sendLine(synthesize());
+        ++m_sent;
+    }
+}
+
+void LoadServer::sendPing()
+{
+    if (!m_client)
+        return;
+
+    // 센서 메시지 스트림 사이에 끼워 보내므로, PONG 은 앞선 메시지가 모두 처리된 뒤에 돌아온다
+    const quint64 seq = m_nextPing++;
+    m_pending.insert(seq, { m_clock.nsecsElapsed(), m_sent });
+    sendLine("PING " + QByteArray::number(seq));
+}
+
+void LoadServer::onReadyRead()
+{
+    if (m_binary) {
+        m_readBuffer.append(m_client->readAll());
+        qsizetype offset = 0;
+        Protocol::Frame frame;
+        qsizetype consumed = 0;
+        while (true) {
+            const Protocol::DecodeResult result = Protocol::decodeFrame(
+                m_readBuffer.constData() + offset, m_readBuffer.size() - offset, &frame, &consumed);
+            if (result == Protocol::DecodeResult::NeedMore)
+                break;
+            if (result == Protocol::DecodeResult::Invalid) {
+                out() << "클라이언트 프레임 오류, 연결 끊음" << Qt::endl;
+                m_client->abort();
+                return;
+            }
+            offset += consumed;
+            handleCommand(Protocol::decodeMessage(frame));
+        }
+        m_readBuffer.remove(0, offset);
+        return;
+    }
+
+    // 클라이언트 명령은 개행 없이 올 수 있으므로 개행으로 나눈 뒤 남는 조각도 한 메시지로 본다
+    const QList<QByteArray> lines = m_client->readAll().split('\n');
+    for (const QByteArray& raw : lines) {
+        const QByteArray line = raw.trimmed();
+        if (!line.isEmpty())
+            handleCommand(line);
+    }
+}
+
+void LoadServer::handleCommand(const QByteArray& line)
+{
+    if (line == Protocol::HelloBinary) {
+        if (!m_config.binary)
+            return;  // 기존 서버처럼 무시 - 클라이언트는 시간 초과 후 텍스트로 계속
+        m_client->write(Protocol::AckBinary);
+        m_client->write("\n", 1);
+        m_binary = true;
+        out() << "바이너리 프레임 사용" << Qt::endl;
+        return;
+    }
+
+    if (line.startsWith("PONG ")) {
+        const QList<QByteArray> parts = line.split(' ');
+        if (parts.size() < 3)
+            return;
+        const quint64 seq = parts[1].toULongLong();
+        const qint64 processed = parts[2].toLongLong();
+        auto it = m_pending.find(seq);
+        if (it == m_pending.end())
+            return;
+
+        const qint64 latencyUs = (m_clock.nsecsElapsed() - it->first) / 1000;
+        m_latenciesUs.append(latencyUs);
+        m_allLatenciesUs.append(latencyUs);
+        m_lastGap = it->second - processed;
+        m_lastProcessed = processed;
+        if (parts.size() >= 4)
+            m_lastCoalesced = parts[3].toLongLong();
+        m_pending.erase(it);
+        return;
+    }
+
+    // 창문 명령에는 실서버처럼 응답
+    if (line == "window_open") {
+        sendLine("ACK OPEN");
+        sendLine("EVT OPENED");
+    } else if (line == "window_close") {
+        sendLine("ACK CLOSE");
+        sendLine("EVT CLOSED");
+    } else if (line == "window_status") {
+        sendLine(QByteArray("{\"pose\":\"CLOSE\",\"angle\":0,\"ts\":")
+                 + QByteArray::number(QDateTime::currentMSecsSinceEpoch()) + "}");
+    } else if (line.startsWith("set_open_angle=")) {
+        sendLine("ACK ANGLE");
+    }
+}
+
+QString LoadServer::coalescedText() const
+{
+    // 예전 클라이언트는 PONG 에 화면 생략 수를 보내지 않는다
+    return m_lastCoalesced < 0 ? QString("-") : QString::number(m_lastCoalesced);
+}
+
+void LoadServer::report()
+{
+    const qint64 sentPerSec = m_sent - m_reportSent;
+    m_reportSent = m_sent;
+
+    out() << QString("[%1s] 전송 %2/s (누계 %3) | 처리 %4 | 누락/병합 %5 | 화면 생략 %6 | 지연 p50 %7ms p99 %8ms max %9ms | 미응답 PING %10 | 송신 대기 %11KB")
+                 .arg(m_clock.elapsed() / 1000)
+                 .arg(sentPerSec)
+                 .arg(m_sent)
+                 .arg(m_lastProcessed)
+                 .arg(m_lastGap)
+                 .arg(coalescedText())
+                 .arg(percentile(m_latenciesUs, 0.50) / 1000.0, 0, 'f', 1)
+                 .arg(percentile(m_latenciesUs, 0.99) / 1000.0, 0, 'f', 1)
+                 .arg(m_latenciesUs.isEmpty() ? 0.0 : *std::max_element(m_latenciesUs.cbegin(), m_latenciesUs.cend()) / 1000.0, 0, 'f', 1)
+                 .arg(m_pending.size())
+                 .arg(m_client ? m_client->bytesToWrite() / 1024 : 0)
+          << Qt::endl;
+    m_latenciesUs.clear();
+}
+
+void LoadServer::printSummary(const char* title)
+{
+    out() << "== " << title << " ==" << Qt::endl
+          << "보낸 센서 메시지: " << m_sent << Qt::endl
+          << "클라이언트 처리: " << m_lastProcessed << " (마지막 PONG 기준)" << Qt::endl
+          << "누락/병합: " << m_lastGap << Qt::endl
+          << "화면 반영 생략: " << coalescedText() << Qt::endl
+          << "PING 응답/미응답: " << m_allLatenciesUs.size() << "/" << m_pending.size() << Qt::endl
+          << QString("처리 지연 p50 %1ms p95 %2ms p99 %3ms")
+                 .arg(percentile(m_allLatenciesUs, 0.50) / 1000.0, 0, 'f', 1)
+                 .arg(percentile(m_allLatenciesUs, 0.95) / 1000.0, 0, 'f', 1)
+                 .arg(percentile(m_allLatenciesUs, 0.99) / 1000.0, 0, 'f', 1)
+          << Qt::endl;
+}
@@ -0,0 +1,96 @@
+#ifndef LOADSERVER_H
+#define LOADSERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QPair>
+#include <QRandomGenerator>
+
+// 대시보드(TcpClient)가 붙는 서버 흉내
+// - 센서 메시지(PLANT/GAS/FIRE/PET)를 초당 rate 개로 합성하거나, 녹화된 트레이스를 시각대로 다시 보낸다
+// - burst 개씩 몰아서 보내 버스트 부하를 흉내낼 수 있다 (평균 속도는 rate 유지)
+// - 클라이언트가 "HELLO BIN1" 을 보내면 "ACK BIN1" 로 답하고 그 뒤로는 protocol.h 의 바이너리 프레임을 쓴다
+// - pingIntervalMs 마다 "PING <seq>" 를 센서 메시지 사이에 끼워 보내고, 클라이언트의 "PONG <seq> <처리 수> [<화면 생략 수>]" 로
+//   앞선 메시지까지 처리하는 데 걸린 시간(지연)과 처리되지 않았거나 합쳐진 메시지 수를 계산한다
+//   화면 생략 수는 클라이언트가 처리했지만 화면 갱신 주기에 묶여 그리지 않은 값 수 (예전 클라이언트는 보내지 않음)
+class LoadServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Config
+    {
+        quint16 port = 8080;
+        double rate = 1000.0;       // 초당 센서 메시지 수
+        int burst = 1;              // 한 번에 몰아서 보내는 메시지 수
+        int durationSec = 0;        // 0 이면 계속
+        int pingIntervalMs = 100;
+        bool newline = true;        // 메시지 끝 개행 (실서버처럼 개행 없이 보내면 합쳐짐 확인 가능)
+        QString replayPath;         // 비어 있으면 합성
+        bool loop = false;          // 트레이스 끝나면 처음부터
+        bool binary = true;         // 클라이언트의 HELLO BIN1 을 받아들여 바이너리 프레임 사용
+    };
+
+    explicit LoadServer(const Config& config, QObject *parent = nullptr);
+
+    bool start();
+
+signals:
+    void finished();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+    void onTick();
+    void sendPing();
+    void report();
+
+private:
+    bool loadReplay();
+    void sendLine(const QByteArray& line);
+    QByteArray synthesize();
+    void handleCommand(const QByteArray& line);
+    void printSummary(const char* title);
+    QString coalescedText() const;  // 마지막 PONG 의 화면 생략 수
+
+    Config m_config;
+    QTcpServer m_server;
+    QTcpSocket *m_client;
+    bool m_binary;                  // 바이너리 프레임 협상 완료
+    QByteArray m_readBuffer;        // 바이너리 모드에서 아직 다 오지 않은 프레임
+
+    QTimer m_tickTimer;
+    QTimer m_pingTimer;
+    QTimer m_reportTimer;
+    QElapsedTimer m_clock;          // 연결 시점부터
+    QRandomGenerator m_random;
+
+    // 합성 상태
+    qint64 m_sent;                  // 보낸 센서 메시지 수
+    int m_plant;
+    int m_gas;
+    int m_fire;                     // 불꽃 센서 값 (낮을수록 불꽃이 가까움, 100 미만이면 대시보드가 화재 위험)
+
+    // 트레이스 재생 (시작 기준 ms, 메시지)
+    QVector<QPair<qint64, QByteArray>> m_replay;
+    int m_replayIndex;
+    qint64 m_replayOffsetMs;
+
+    // PING 왕복
+    quint64 m_nextPing;
+    QHash<quint64, QPair<qint64, qint64>> m_pending;  // seq -> (보낸 시각 ns, 그때까지 보낸 센서 메시지 수)
+    QVector<qint64> m_latenciesUs;                    // 보고 주기 동안
+    QVector<qint64> m_allLatenciesUs;
+    qint64 m_lastProcessed;
+    qint64 m_lastGap;                                 // 보낸 수 - 처리 수 (PING 시점 기준)
+    qint64 m_lastCoalesced;                           // 클라이언트가 화면에 반영하지 않은 값 수 (없으면 -1)
+    qint64 m_reportSent;
+};
+
+#endif // LOADSERVER_H
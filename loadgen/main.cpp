@@ -0,0 +1,43 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include "loadserver.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("smart_home_loadgen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("대시보드 TCP 부하 시험용 센서 서버");
+    parser.addHelpOption();
+
+    QCommandLineOption portOption("port", "대기 포트", "port", "8080");
+    QCommandLineOption rateOption("rate", "초당 센서 메시지 수", "msgs", "1000");
+    QCommandLineOption burstOption("burst", "한 번에 몰아서 보내는 메시지 수", "count", "1");
+    QCommandLineOption durationOption("duration", "시험 시간 (초, 0 = 계속)", "sec", "0");
+    QCommandLineOption pingOption("ping-interval", "지연 측정 PING 간격 (ms)", "ms", "100");
+    QCommandLineOption noNewlineOption("no-newline", "메시지 끝에 개행을 붙이지 않음 (실서버와 같은 방식)");
+    QCommandLineOption replayOption("replay", "트레이스 파일 재생 (\"<ms> <메시지>\" 한 줄씩)", "file");
+    QCommandLineOption loopOption("loop", "트레이스를 반복 재생");
+    QCommandLineOption textOnlyOption("text-only", "바이너리 프레임 협상을 거절 (기존 텍스트 서버 흉내)");
+    parser.addOptions({ portOption, rateOption, burstOption, durationOption, pingOption,
+                        noNewlineOption, replayOption, loopOption, textOnlyOption });
+    parser.process(app);
+
+    LoadServer::Config config;
+    config.port = quint16(parser.value(portOption).toUInt());
+    config.rate = parser.value(rateOption).toDouble();
+    config.burst = parser.value(burstOption).toInt();
+    config.durationSec = parser.value(durationOption).toInt();
+    config.pingIntervalMs = qMax(1, parser.value(pingOption).toInt());
+    config.newline = !parser.isSet(noNewlineOption);
+    config.replayPath = parser.value(replayOption);
+    config.loop = parser.isSet(loopOption);
+    config.binary = !parser.isSet(textOnlyOption);
+
+    LoadServer server(config);
+    QObject::connect(&server, &LoadServer::finished, &app, &QCoreApplication::quit);
+    if (!server.start())
+        return 1;
+    return app.exec();
+}
@@ -1,11 +1,18 @@
 #include <QApplication>
 #include <QStyleFactory>
 #include <QDir>
+#include <QDebug>
+#include <QStandardPaths>
+#include <QCommandLineParser>
 #include "mainwindow.h"
 #include "database.h"
+#include "sensorstore.h"
+#include "profiler.h"
 
 int main(int argc, char *argv[])
 {
+    // 프로파일러 시계는 첫 instance() 호출부터 - QApplication 생성 시간도 포함되도록 먼저 호출
+    Profiler& profiler = Profiler::instance();
     QApplication app(argc, argv);
 
     // Set application properties
@@ -13,15 +20,61 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("2.0");
     app.setOrganizationName("SmartHome Inc.");
 
-    // db 연결
+    // 페이지들이 생성될 때 설정하던 앱 기본 글꼴 - 페이지를 늦게 만들어도 대시보드 글꼴이 바뀌지 않도록 먼저 설정
+    app.setFont(QFont("sans-serif", 10));
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption prewarmOption("prewarm-pages",
+                                     "첫 화면을 그린 뒤 Safety/Certified/Search 페이지를 미리 생성");
+    parser.addOption(prewarmOption);
+    QCommandLineOption traceOption("trace",
+                                   "구간 시간을 기록해 종료 시 Chrome trace JSON 으로 저장하고 요약을 출력",
+                                   "file");
+    parser.addOption(traceOption);
+    QCommandLineOption uiRateOption("ui-hz",
+                                    "TCP 센서 값을 카드에 반영하는 초당 최대 횟수 (기본: 화면 주사율)",
+                                    "hz");
+    parser.addOption(uiRateOption);
+    QCommandLineOption binaryProtocolOption("binary-protocol",
+                                            "서버와 길이 접두 바이너리 프레임 협상 (HELLO BIN1, 지원하지 않으면 텍스트 유지)");
+    parser.addOption(binaryProtocolOption);
+    parser.process(app);
+
+    const QString tracePath = parser.value(traceOption);
+    if (!tracePath.isEmpty())
+        profiler.setEnabled(true);
+
+    // 로컬 센서 저장소 - DB 와 상관없이 TCP 센서 값을 기록하고 오프라인 검색에 사용
+    SensorStore& store = SensorStore::instance();
+    store.open(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/sensors");
+
+    // db 접속 정보 - 실제 연결은 창을 띄운 뒤 MainWindow 가 작업 스레드에서 재시도하며 진행
+    // (연결 전까지는 로컬 저장소로 동작)
     Database& db = Database::instance();
-    if (!db.connect("127.0.0.1", "hometer", "root", "1111")) {
-        return -1; // 연결 실패 시 종료
-    }
+    db.configure("127.0.0.1", "hometer", "root", "1111");
 
     // Create and show main window
     MainWindow window;
+    if (parser.isSet(uiRateOption))
+        window.setUiUpdateRate(parser.value(uiRateOption).toDouble());
+    window.setBinaryProtocol(parser.isSet(binaryProtocolOption));
+    // show() 직후의 0ms 타이머는 첫 그리기보다 먼저 돌 수 있으므로, 미리 생성은 첫 paintEvent 에서 시작한다
+    window.setPrewarmPages(parser.isSet(prewarmOption));
+    window.startServices();
     window.show();
 
-    return app.exec();
+    int result = app.exec();
+
+    // DB 작업 스레드를 QApplication 이 살아있는 동안 정리
+    db.disconnect();
+    store.close();
+
+    if (!tracePath.isEmpty()) {
+        if (profiler.writeChromeTrace(tracePath))
+            qInfo().noquote() << "트레이스 저장:" << tracePath;
+        qInfo().noquote() << "\n" + profiler.summary();
+    }
+    return result;
 }
@@ -6,7 +6,10 @@
 #include <QKeyEvent>
 #include <QDebug>
 #include <QRandomGenerator>
+#include <iterator>
 #include "database.h"
+#include "sensorstore.h"
+#include "profiler.h"
 
 //=============================================================================
 // COLOR CONSTANTS - Exact Match to Design
@@ -31,46 +34,78 @@ const QColor StatusOptimal(0x4C, 0xAF, 0x50);        // #4CAF50 - 최적 색상
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , isWindowOpen(false)
+    , windowAngle(-1)
+    , windowStateTs(0)
     , fireAlert(false)
     , gasAlert(false)
     , tcpClient(nullptr)
     , clockTimer(nullptr)
-    , dbUpdateTimer(nullptr)
+    , changeFeed(nullptr)
+    , dbRequestInFlight(false)
+    , dbRetryDelayMs(1000)
+    , firstPaintRecorded(false)
+    , tcpMessagesProcessed(0)
+    , binaryProtocol(false)
+    , prewarmAfterFirstPaint(false)
+    , uiScheduler(nullptr)
     , currentPlantStatus(SensorStatus::Normal)
     , currentGasStatus(SensorStatus::Normal)
     , currentFireStatus(SensorStatus::Normal)
     , currentPetPoopDetected(false)
 {
+    PROFILE_SCOPE("MainWindow::MainWindow");
     setupUI();
     setupStyles();
 
+    uiScheduler = new UiUpdateScheduler(this);
+    uiScheduler->setRate(QApplication::primaryScreen()->refreshRate());
+    uiScheduler->setSlot(int(UiCard::Plant), [this](int value) { updatePlantHumidityStatus(value); });
+    uiScheduler->setSlot(int(UiCard::Gas), [this](int value) { updateGasStatus(value); });
+    uiScheduler->setSlot(int(UiCard::Fire), [this](int value) { updateFireStatus(value); });
+    uiScheduler->setSlot(int(UiCard::Pet), [this](int value) { updatePetStatus(value != 0); });
+
+    // 시계 타이머 초기화 및 시작
+    clockTimer = new QTimer(this);
+    connect(clockTimer, &QTimer::timeout, this, &MainWindow::updateClock);
+    clockTimer->start(1000);
+    updateClock();
+
+    // 변경 감지 - 시그널 연결만 해 두고 시작은 startServices() 에서
+    changeFeed = new ChangeFeed(this);
+    connect(changeFeed, &ChangeFeed::homeEnvChanged, this, &MainWindow::refreshHomeEnv);
+    connect(changeFeed, &ChangeFeed::fireEventsChanged, this, &MainWindow::refreshFireStatus);
+    connect(changeFeed, &ChangeFeed::plantEnvChanged, this, &MainWindow::refreshSoilMoisture);
+    connect(changeFeed, &ChangeFeed::petStatusChanged, this, &MainWindow::refreshPetStatus);
+}
+
+void MainWindow::startServices()
+{
+    if (tcpClient)
+        return;
+
     // TCP 클라이언트 초기화 (서버 문서에 맞춰 8080 포트)
     tcpClient = new TcpClient(this);
 
     // TCP 클라이언트 시그널 연결
     connect(tcpClient, &TcpClient::connected, this, &MainWindow::onTcpConnected);
     connect(tcpClient, &TcpClient::disconnected, this, &MainWindow::onTcpDisconnected);
-    connect(tcpClient, &TcpClient::messageReceived, this, &MainWindow::onTcpMessageReceived);
+    connect(tcpClient, &TcpClient::eventsReceived, this, &MainWindow::onTcpEvents);
     connect(tcpClient, &TcpClient::errorOccurred, this, &MainWindow::onTcpErrorOccurred);
 
-    // 자동으로 서버에 연결 시도 (127.0.0.1:8080)
+    // 자동으로 서버에 연결 시도 (127.0.0.1:8080) - 실패/끊김 시 대기 시간을 늘려 가며 재연결
+    tcpClient->setAutoReconnect(true);
+    tcpClient->setBinaryFraming(binaryProtocol);  // 켜져 있고 서버가 지원하면 길이 접두 바이너리 프레임 사용
     tcpClient->connectToServer();
 
-    // 시계 타이머 초기화 및 시작
-    clockTimer = new QTimer(this);
-    connect(clockTimer, &QTimer::timeout, this, &MainWindow::updateClock);
-    clockTimer->start(1000);
-    updateClock();
-
-    // DB 업데이트 타이머 초기화 및 시작
-    dbUpdateTimer = new QTimer(this);
-    connect(dbUpdateTimer, &QTimer::timeout, this, &MainWindow::updateDbData);
-    dbUpdateTimer->start(5000);
-    updateDbData();
+    // 창을 먼저 띄우고 DB 는 작업 스레드에서 연결 - 연결되면 최초 1회 전체 스냅샷 조회 후,
+    // 이후에는 새 행이 들어온 테이블만 갱신 (그 전까지 카드는 "--" 로 표시)
+    connectDatabase();
+    changeFeed->start(1000);
 }
 
 void MainWindow::setupUI()
 {
+    PROFILE_SCOPE("MainWindow::setupUI");
     // Set window to fullscreen with screen size
     QScreen *screen = QApplication::primaryScreen();
     QRect screenGeometry = screen->availableGeometry();
@@ -90,49 +125,17 @@ void MainWindow::setupUI()
     QWidget *dashboardPage = new QWidget();
     dashboardPage->setObjectName("dashboardPage");
 
-    // Create other pages
-    safetyWidget = new Safety();
-    certifiedWidget = new Certified();
-    searchWidget = new Search();
+    // 다른 페이지는 처음 이동할 때 만든다 - 대시보드만 쓰는 경우 시작 시간/메모리 절약
+    safetyWidget = nullptr;
+    certifiedWidget = nullptr;
+    searchWidget = nullptr;
 
-    // Connect page navigation
-    connect(safetyWidget, &Safety::backToMain, this, [this]() {
-        stackedWidget->setCurrentIndex(0);
-    });
-    connect(safetyWidget, &Safety::goToCertified, this, [this]() {
-        stackedWidget->setCurrentIndex(2);
-    });
-    connect(certifiedWidget, &Certified::backToMain, this, [this]() {
-        stackedWidget->setCurrentIndex(0);
-    });
-    connect(certifiedWidget, &Certified::goToSafety, this, [this]() {
-        stackedWidget->setCurrentIndex(1);
-    });
-    connect(searchWidget, &Search::backToMain, this, [this]() {
-        stackedWidget->setCurrentIndex(0);
-    });
-    connect(searchWidget, &Search::goToSafety, this, [this]() {
-        stackedWidget->setCurrentIndex(1);
-    });
-    connect(searchWidget, &Search::goToCertified, this, [this]() {
-        stackedWidget->setCurrentIndex(2);
-    });
-    // Safety에서 Search로 가는 시그널 연결 추가
-    connect(safetyWidget, &Safety::goToSearch, this, [this]() {
-        stackedWidget->setCurrentIndex(3);
-    });
-
-    // Certified에서 Search로 가는 시그널 연결 추가
-    connect(certifiedWidget, &Certified::goToSearch, this, [this]() {
-        stackedWidget->setCurrentIndex(3);
-    });
-
-    // Add pages to stack
+    // Add pages to stack (Page 순서와 같게, 대시보드 외에는 빈 자리 표시 위젯)
     stackedWidget->addWidget(dashboardPage);
-    stackedWidget->addWidget(safetyWidget);
-    stackedWidget->addWidget(certifiedWidget);
-    stackedWidget->addWidget(searchWidget);
-    stackedWidget->setCurrentIndex(0);
+    stackedWidget->addWidget(new QWidget());
+    stackedWidget->addWidget(new QWidget());
+    stackedWidget->addWidget(new QWidget());
+    stackedWidget->setCurrentIndex(static_cast<int>(Page::Dashboard));
 
     // Central layout
     QVBoxLayout *centralLayout = new QVBoxLayout(centralWidget);
@@ -149,98 +152,270 @@ void MainWindow::setupUI()
     connect(searchButton, &QPushButton::clicked, this, &MainWindow::onSearchClicked);
 }
 
-void MainWindow::updateDbData()
+void MainWindow::connectDatabase()
 {
-    // 온습도 데이터 조회 및 업데이트
-    auto homeInfo = Database::instance().getLatestHomeEnv("1");
-    if (homeInfo.has_value()) {
-        double temperature = homeInfo.value().first;
-        double humidity = homeInfo.value().second;
-
-        // 온도 카드 업데이트
-        if (tempCard) {
-            QLabel* tempValueLabel = tempCard->findChild<QLabel*>("cardValue");
-            if (tempValueLabel) {
-                tempValueLabel->setText(QString::number((int)temperature) + "°C");
-            }
+    const qint64 startUs = Profiler::instance().nowUs();
+    Database::instance().connectAsync().then(this, [this, startUs](bool connected) {
+        if (Profiler::instance().isEnabled())
+            Profiler::instance().record("Database::connectAsync", startUs, Profiler::instance().nowUs() - startUs);
+
+        if (connected) {
+            dbRetryDelayMs = 1000;
+            updateDbData();
+            return;
         }
 
-        // 습도 카드 업데이트
-        if (humCard) {
-            QLabel* humValueLabel = humCard->findChild<QLabel*>("cardValue");
-            if (humValueLabel) {
-                humValueLabel->setText(QString::number(humidity, 'f', 0) + "%");
-            }
-        }
+        qWarning() << "DB 연결 실패 -" << dbRetryDelayMs << "ms 후 재시도 (그동안 로컬 센서 기록만 사용)";
+        QTimer::singleShot(dbRetryDelayMs, this, &MainWindow::connectDatabase);
+        dbRetryDelayMs = qMin(dbRetryDelayMs * 2, 60000);
+    });
+}
+
+void MainWindow::paintEvent(QPaintEvent *event)
+{
+    QMainWindow::paintEvent(event);
+
+    // 프로세스 시작부터 첫 그리기까지를 한 구간으로 기록
+    if (!firstPaintRecorded) {
+        firstPaintRecorded = true;
+        if (Profiler::instance().isEnabled())
+            Profiler::instance().record("MainWindow::firstPaint", 0, Profiler::instance().nowUs());
+
+        // 지금은 그리기 도중이므로 페이지 생성은 이벤트 루프로 돌아간 다음으로 미룬다
+        if (prewarmAfterFirstPaint)
+            QTimer::singleShot(0, this, &MainWindow::prewarmPages);
     }
+}
 
-    // 화재 상태 조회 및 업데이트
-    auto fireInfo = Database::instance().getLatestFireStatus("1");
-    if (fireInfo.has_value()) {
-        QString fireStatus = fireInfo.value().first;
-        QString gasLevel = fireInfo.value().second;
-
-        // 화재 카드 업데이트
-        if (fireCard) {
-            QLabel* fireStatusLabel = fireCard->findChild<QLabel*>("statusLabel");
-            if (fireStatusLabel) {
-                if (fireStatus == "화재") {
-                    fireStatusLabel->setText("화재");
-                    updateCardColor(fireCard, SensorStatus::Danger);
-                } else {
-                    fireStatusLabel->setText("정상");
-                    updateCardColor(fireCard, SensorStatus::Normal);
-                }
-            }
-        }
+void MainWindow::showPage(Page page)
+{
+    stackedWidget->setCurrentWidget(ensurePage(page));
+}
 
-        // 가스 카드 업데이트
-        if (gasCard) {
-            QLabel* gasStatusLabel = gasCard->findChild<QLabel*>("statusLabel");
-            if (gasStatusLabel) {
-                if (gasLevel == "위험") {
-                    gasStatusLabel->setText("위험");
-                    updateCardColor(gasCard, SensorStatus::Danger);
-                } else {
-                    gasStatusLabel->setText("정상");
-                    updateCardColor(gasCard, SensorStatus::Normal);
-                }
-            }
+QWidget* MainWindow::ensurePage(Page page)
+{
+    const int index = static_cast<int>(page);
+    QWidget *widget = nullptr;
+
+    switch (page) {
+    case Page::Dashboard:
+        return stackedWidget->widget(index);
+
+    case Page::Safety:
+        if (safetyWidget)
+            return safetyWidget;
+        safetyWidget = new Safety();
+        connect(safetyWidget, &Safety::backToMain, this, [this]() { showPage(Page::Dashboard); });
+        connect(safetyWidget, &Safety::goToCertified, this, [this]() { showPage(Page::Certified); });
+        connect(safetyWidget, &Safety::goToSearch, this, [this]() { showPage(Page::Search); });
+        widget = safetyWidget;
+        break;
+
+    case Page::Certified:
+        if (certifiedWidget)
+            return certifiedWidget;
+        certifiedWidget = new Certified();
+        connect(certifiedWidget, &Certified::backToMain, this, [this]() { showPage(Page::Dashboard); });
+        connect(certifiedWidget, &Certified::goToSafety, this, [this]() { showPage(Page::Safety); });
+        connect(certifiedWidget, &Certified::goToSearch, this, [this]() { showPage(Page::Search); });
+        widget = certifiedWidget;
+        break;
+
+    case Page::Search:
+        if (searchWidget)
+            return searchWidget;
+        searchWidget = new Search();
+        connect(searchWidget, &Search::backToMain, this, [this]() { showPage(Page::Dashboard); });
+        connect(searchWidget, &Search::goToSafety, this, [this]() { showPage(Page::Safety); });
+        connect(searchWidget, &Search::goToCertified, this, [this]() { showPage(Page::Certified); });
+        // 새 행이 들어온 테이블은 그 행들의 시각 이후 검색 캐시를 잘라 늦게 도착한 과거 시각 행을 놓치지 않도록
+        connect(changeFeed, &ChangeFeed::homeEnvChanged, searchWidget,
+                [this](qint64 sinceId) { searchWidget->invalidateCache(SearchCategory::HomeEnv, sinceId); });
+        connect(changeFeed, &ChangeFeed::fireEventsChanged, searchWidget, [this](qint64 sinceId) {
+            searchWidget->invalidateCache(SearchCategory::Fire, sinceId);
+            searchWidget->invalidateCache(SearchCategory::Gas, sinceId);
+        });
+        connect(changeFeed, &ChangeFeed::plantEnvChanged, searchWidget,
+                [this](qint64 sinceId) { searchWidget->invalidateCache(SearchCategory::Plant, sinceId); });
+        connect(changeFeed, &ChangeFeed::petStatusChanged, searchWidget,
+                [this](qint64 sinceId) { searchWidget->invalidateCache(SearchCategory::Pet, sinceId); });
+        widget = searchWidget;
+        break;
+    }
+
+    // 자리 표시 위젯을 실제 페이지로 교체 (현재 페이지 인덱스는 그대로 유지됨)
+    QWidget *placeholder = stackedWidget->widget(index);
+    stackedWidget->insertWidget(index, widget);
+    stackedWidget->removeWidget(placeholder);
+    placeholder->deleteLater();
+    return widget;
+}
+
+void MainWindow::prewarmPages()
+{
+    // 한 번에 하나씩 만들고 다음 것은 다시 이벤트 루프 뒤로 미뤄 화면 갱신/입력이 막히지 않게 한다
+    const Page pages[] = { Page::Search, Page::Safety, Page::Certified };
+    for (Page page : pages) {
+        const bool created = (page == Page::Search && searchWidget)
+                             || (page == Page::Safety && safetyWidget)
+                             || (page == Page::Certified && certifiedWidget);
+        if (created)
+            continue;
+
+        ensurePage(page);
+        QTimer::singleShot(0, this, &MainWindow::prewarmPages);
+        return;
+    }
+}
+
+void MainWindow::updateDbData()
+{
+    // 이전 조회가 아직 끝나지 않았거나 (DB 지연) DB 없이 동작 중이면 건너뜀
+    if (dbRequestInFlight || !Database::instance().isConnected())
+        return;
+
+    PROFILE_SCOPE("MainWindow::updateDbData");
+    dbRequestInFlight = true;
+    const qint64 startUs = Profiler::instance().nowUs();
+    Database::instance().getDashboardSnapshotAsync("1").then(this, [this, startUs](std::optional<DashboardSnapshot> snapshot) {
+        PROFILE_SCOPE("MainWindow::updateDbData.apply");
+        // 요청부터 결과 도착까지 (DB 왕복 포함)
+        if (Profiler::instance().isEnabled())
+            Profiler::instance().record("MainWindow::updateDbData.roundTrip", startUs, Profiler::instance().nowUs() - startUs);
+        dbRequestInFlight = false;
+        if (snapshot.has_value())
+            applyDashboardSnapshot(snapshot.value());
+    });
+}
+
+void MainWindow::applyDashboardSnapshot(const DashboardSnapshot& snapshot)
+{
+    if (snapshot.homeEnv.has_value())
+        applyHomeEnv(snapshot.homeEnv.value());
+    if (snapshot.fireStatus.has_value())
+        applyFireStatus(snapshot.fireStatus.value());
+    if (snapshot.soilMoisture.has_value())
+        applySoilMoisture(snapshot.soilMoisture.value());
+    if (snapshot.petToilet.has_value())
+        applyPetToilet(snapshot.petToilet.value());
+}
+
+//=============================================================================
+// 변경 감지 기반 카드별 갱신 (ChangeFeed 시그널 -> 해당 테이블만 조회)
+//=============================================================================
+void MainWindow::refreshHomeEnv(qint64 sinceId)
+{
+    Database::instance().getLatestHomeEnvAsync("1", sinceId).then(this, [this](std::optional<QPair<double, double>> homeInfo) {
+        if (homeInfo.has_value())
+            applyHomeEnv(homeInfo.value());
+    });
+}
+
+void MainWindow::refreshFireStatus(qint64 sinceId)
+{
+    Database::instance().getLatestFireStatusAsync("1", sinceId).then(this, [this](std::optional<QPair<QString, QString>> fireInfo) {
+        if (fireInfo.has_value())
+            applyFireStatus(fireInfo.value());
+    });
+}
+
+void MainWindow::refreshSoilMoisture(qint64 sinceId)
+{
+    Database::instance().getLatestSoilMoistureAsync("1", sinceId).then(this, [this](std::optional<int> soilInfo) {
+        if (soilInfo.has_value())
+            applySoilMoisture(soilInfo.value());
+    });
+}
+
+void MainWindow::refreshPetStatus(qint64 sinceId)
+{
+    Database::instance().getLatestPetToiletAsync("1", sinceId).then(this, [this](std::optional<QString> petInfo) {
+        if (petInfo.has_value())
+            applyPetToilet(petInfo.value());
+    });
+}
+
+void MainWindow::applyHomeEnv(const QPair<double, double>& homeEnv)
+{
+    double temperature = homeEnv.first;
+    double humidity = homeEnv.second;
+
+    // 온도 카드 업데이트
+    if (tempCard) {
+        QLabel* tempValueLabel = tempCard->findChild<QLabel*>("cardValue");
+        if (tempValueLabel) {
+            tempValueLabel->setText(QString::number((int)temperature) + "°C");
         }
     }
 
-    // 식물 습도 조회 및 업데이트
-    auto soilInfo = Database::instance().getLatestSoilMoisture("1");
-    if (soilInfo.has_value()) {
-        int soilMoisture = soilInfo.value();
+    // 습도 카드 업데이트
+    if (humCard) {
+        QLabel* humValueLabel = humCard->findChild<QLabel*>("cardValue");
+        if (humValueLabel) {
+            humValueLabel->setText(QString::number(humidity, 'f', 0) + "%");
+        }
+    }
+}
 
-        if (plantCard) {
-            QLabel* plantValueLabel = plantCard->findChild<QLabel*>("cardValue");
-            if (plantValueLabel) {
-                plantValueLabel->setText(QString::number(soilMoisture) + "%");
+void MainWindow::applyFireStatus(const QPair<QString, QString>& fireInfo)
+{
+    QString fireStatus = fireInfo.first;
+    QString gasLevel = fireInfo.second;
+
+    // 화재 카드 업데이트
+    if (fireCard) {
+        QLabel* fireStatusLabel = fireCard->findChild<QLabel*>("statusLabel");
+        if (fireStatusLabel) {
+            if (fireStatus == "화재") {
+                fireStatusLabel->setText("화재");
+                updateCardColor(fireCard, SensorStatus::Danger);
+            } else {
+                fireStatusLabel->setText("정상");
+                updateCardColor(fireCard, SensorStatus::Normal);
             }
+        }
+    }
 
-            // 식물 습도 상태에 따른 색상 업데이트
-            if (soilMoisture < 36) {
-                updateCardColor(plantCard, SensorStatus::Danger);
-            } else if (soilMoisture > 55) {
-                updateCardColor(plantCard, SensorStatus::Optimal);
+    // 가스 카드 업데이트
+    if (gasCard) {
+        QLabel* gasStatusLabel = gasCard->findChild<QLabel*>("statusLabel");
+        if (gasStatusLabel) {
+            if (gasLevel == "위험") {
+                gasStatusLabel->setText("위험");
+                updateCardColor(gasCard, SensorStatus::Danger);
             } else {
-                updateCardColor(plantCard, SensorStatus::Normal);
+                gasStatusLabel->setText("정상");
+                updateCardColor(gasCard, SensorStatus::Normal);
             }
         }
     }
+}
 
-    // 펫 상태 조회 및 업데이트
-    auto petInfo = Database::instance().getLatestPetToilet("1");
-    if (petInfo.has_value()) {
-        QString toiletStatus = petInfo.value();
-        bool needsCleaning = (toiletStatus == "청소 필요");
+void MainWindow::applySoilMoisture(int soilMoisture)
+{
+    if (plantCard) {
+        QLabel* plantValueLabel = plantCard->findChild<QLabel*>("cardValue");
+        if (plantValueLabel) {
+            plantValueLabel->setText(QString::number(soilMoisture) + "%");
+        }
 
-        updatePetStatus(needsCleaning);
+        // 식물 습도 상태에 따른 색상 업데이트
+        if (soilMoisture < 36) {
+            updateCardColor(plantCard, SensorStatus::Danger);
+        } else if (soilMoisture > 55) {
+            updateCardColor(plantCard, SensorStatus::Optimal);
+        } else {
+            updateCardColor(plantCard, SensorStatus::Normal);
+        }
     }
 }
 
+void MainWindow::applyPetToilet(const QString& toiletStatus)
+{
+    bool needsCleaning = (toiletStatus == "청소 필요");
+    updatePetStatus(needsCleaning);
+}
+
 void MainWindow::setupDashboardLayout(QWidget *dashboardPage)
 {
     // Main layout with reduced margins (위쪽 여백 줄임)
@@ -314,8 +489,9 @@ void MainWindow::createCardsGrid(QHBoxLayout *mainLayout)
     gridLayout->setContentsMargins(0, 0, 0, 0);
 
     // Create cards following exact design layout (Lock 카드 제거)
-    tempCard = createSensorCard("Temperature", "20°C", "thermometer");
-    humCard = createSensorCard("Humidity", "50%", "droplet");
+    // 첫 값이 들어오기 전까지는 "--" 로 표시
+    tempCard = createSensorCard("Temperature", "--°C", "thermometer");
+    humCard = createSensorCard("Humidity", "--%", "droplet");
     petCard = createPetCard();
 
     fireCard = createStatusCard("Fire Detection");
@@ -349,7 +525,7 @@ void MainWindow::createRightSideCards(QHBoxLayout *mainLayout)
     // Create right side cards with fixed width
     clockCard = createClockCard();
     windowCard = createWindowCard();
-    plantCard = createSensorCard("Plant Humidity", "60%", "plant");
+    plantCard = createSensorCard("Plant Humidity", "--%", "plant");
 
     rightLayout->addWidget(clockCard);
     rightLayout->addWidget(windowCard);
@@ -519,7 +695,7 @@ void MainWindow::updateGasStatus(int value)
     } else if (value > 200 && value <= 500) {
         newStatus = SensorStatus::Normal;
         statusText = "정상";
-    } else if (value >= 1000) {
+    } else if (isGasDanger(value)) {
         newStatus = SensorStatus::Danger;
         statusText = "위험";
     } else {
@@ -541,7 +717,7 @@ void MainWindow::updateFireStatus(int value)
     SensorStatus newStatus;
     QString statusText;
 
-    if (value < 100) {
+    if (isFireDanger(value)) {
         newStatus = SensorStatus::Danger;
         statusText = "화재 위험";
     } else {
@@ -558,6 +734,33 @@ void MainWindow::updateFireStatus(int value)
     }
 }
 
+bool MainWindow::isGasDanger(int value)
+{
+    return value >= 1000;
+}
+
+bool MainWindow::isFireDanger(int value)
+{
+    return value < 100;
+}
+
+void MainWindow::setUiUpdateRate(double hz)
+{
+    uiScheduler->setRate(hz);
+}
+
+void MainWindow::setBinaryProtocol(bool enabled)
+{
+    binaryProtocol = enabled;
+    if (tcpClient)
+        tcpClient->setBinaryFraming(enabled);  // 다음 연결부터 적용
+}
+
+void MainWindow::setPrewarmPages(bool enabled)
+{
+    prewarmAfterFirstPaint = enabled;
+}
+
 void MainWindow::updateCardColor(QWidget* card, SensorStatus status)
 {
     if (!card) return;
@@ -902,8 +1105,8 @@ QWidget* MainWindow::createStatusCard(const QString& title)
         iconLabel->setStyleSheet("font-size: 48px; color: #2F3A56;");
     }
 
-    // Status (initially Normal)
-    QLabel *statusLabel = new QLabel("Normal");
+    // Status (첫 값이 들어오기 전까지 "--")
+    QLabel *statusLabel = new QLabel("--");
     statusLabel->setObjectName("statusLabel");
     statusLabel->setAlignment(Qt::AlignCenter);
     QFont statusFont("Arial", 20, QFont::Bold);
@@ -1053,6 +1256,7 @@ QPushButton* MainWindow::createCircleButton(const QString& iconPath)
 //=============================================================================
 void MainWindow::setupStyles()
 {
+    PROFILE_SCOPE("MainWindow::setupStyles");
     QString styles = QString(
                          // Main background
                          "QWidget#centralWidget {"
@@ -1271,10 +1475,7 @@ void MainWindow::updateClock()
 void MainWindow::toggleWindow()
 {
     isWindowOpen = windowToggle->isChecked();
-
-    if (windowLabel) {
-        windowLabel->setText(isWindowOpen ? "Open" : "Close");
-    }
+    updateWindowLabel();
 
     // TCP 서버로 창문 제어 명령 전송 (서버 문서 기준)
     if (tcpClient && tcpClient->isConnected()) {
@@ -1308,22 +1509,22 @@ void MainWindow::setWindowAngle(int angle)
 
 void MainWindow::onCameraClicked()
 {
-    stackedWidget->setCurrentIndex(1);
+    showPage(Page::Safety);
 }
 
 void MainWindow::onHomeClicked()
 {
-    stackedWidget->setCurrentIndex(0);
+    showPage(Page::Dashboard);
 }
 
 void MainWindow::onSecurityClicked()
 {
-    stackedWidget->setCurrentIndex(2);
+    showPage(Page::Certified);
 }
 
 void MainWindow::onSearchClicked()
 {
-    stackedWidget->setCurrentIndex(3);
+    showPage(Page::Search);
 }
 
 void MainWindow::toggleFireAlert()
@@ -1353,96 +1554,152 @@ void MainWindow::onTcpConnected()
 void MainWindow::onTcpDisconnected()
 {
     qDebug() << "[TCP] Disconnected from Smart Home Server";
+    // 재연결은 TcpClient 가 대기 시간을 늘려 가며 자동으로 시도
+}
 
-    // 연결 끊어진 경우 자동 재연결 시도
-    QTimer::singleShot(5000, this, [this]() {
-        if (tcpClient && !tcpClient->isConnected()) {
-            qDebug() << "[TCP] Attempting to reconnect to Smart Home Server...";
-            tcpClient->connectToServer();
-        }
-    });
+void MainWindow::onTcpEvents(const TcpEventBatch& batch)
+{
+    // 네트워크 스레드가 한 번 읽을 때마다 모아 보낸 이벤트 (이미 해석된 상태)
+    PROFILE_SCOPE("MainWindow::onTcpEvents");
+    for (int i = 0; i < batch.size(); ++i)
+        onTcpEvent(batch.at(i));
 }
 
-void MainWindow::onTcpMessageReceived(const QString& message)
+void MainWindow::onTcpEvent(const SensorEvent& event)
 {
-    qDebug() << "[TCP] Received:" << message;
+    // SensorEvent::Type 순서대로의 처리 함수 표 (메시지는 TcpClient 의 파서가 한 번만 해석)
+    // 새 메시지 종류는 SensorEvent::Type, 파서의 kMessageKinds, 이 표에 한 줄씩 추가
+    static constexpr TcpEventHandler handlers[] = {
+        &MainWindow::handlePlantEvent,          // Plant
+        &MainWindow::handleGasEvent,            // Gas
+        &MainWindow::handleFireEvent,           // Fire
+        &MainWindow::handlePetEvent,            // Pet
+        &MainWindow::handlePingEvent,           // Ping
+        &MainWindow::handleAckEvent,            // Ack
+        &MainWindow::handleServerEvent,         // Evt
+        &MainWindow::handleWindowStatusEvent,   // WindowStatus
+        &MainWindow::handleUnknownEvent,        // Json
+        &MainWindow::handleUnknownEvent,        // Text
+    };
+    static_assert(std::size(handlers) == size_t(SensorEvent::Type::Count),
+                  "SensorEvent::Type 마다 처리 함수가 있어야 함");
+
+    (this->*handlers[int(event.type)])(event);
+}
 
-    // 서버 문서에 따른 응답 처리
-    if (message.startsWith("ACK")) {
-        // 명령 확인 응답: "ACK OPEN", "ACK CLOSE" 등
-        QStringList parts = message.split(" ");
-        if (parts.size() >= 2) {
-            QString command = parts[1];
-            qDebug() << "Server acknowledged command:" << command;
-        }
-    }
-    else if (message.startsWith("EVT")) {
-        // 이벤트 응답: "EVT OPENED", "EVT CLOSED" 등
-        QStringList parts = message.split(" ");
-        if (parts.size() >= 2) {
-            QString event = parts[1];
-            qDebug() << "Server event:" << event;
-
-            // UI 상태 업데이트
-            if (event == "OPENED") {
-                isWindowOpen = true;
-                if (windowToggle) windowToggle->setChecked(true);
-                if (windowLabel) windowLabel->setText("Open");
-            }
-            else if (event == "CLOSED") {
-                isWindowOpen = false;
-                if (windowToggle) windowToggle->setChecked(false);
-                if (windowLabel) windowLabel->setText("Close");
-            }
-        }
-    }
-    else if (message.startsWith("{") && message.endsWith("}")) {
-        // JSON 상태 응답: {"pose":"OPEN","angle":100}
-        qDebug() << "Window status JSON:" << message;
-
-        // JSON 파싱 (간단한 방법)
-        if (message.contains("\"pose\":\"OPEN\"")) {
-            isWindowOpen = true;
-            if (windowToggle) windowToggle->setChecked(true);
-            if (windowLabel) windowLabel->setText("Open");
-        }
-        else if (message.contains("\"pose\":\"CLOSE\"")) {
-            isWindowOpen = false;
-            if (windowToggle) windowToggle->setChecked(false);
-            if (windowLabel) windowLabel->setText("Close");
-        }
-    }
-    else {
-        // 센서 데이터 처리 (기존 로직 유지)
-        QStringList parts = message.split(":");
-        if (parts.size() >= 2) {
-            QString sensor = parts[0].toUpper();
-            QString value = parts[1];
-
-            if (sensor == "PLANT") {
-                bool ok;
-                int plantValue = value.toInt(&ok);
-                if (ok) {
-                    updatePlantHumidityStatus(plantValue);
-                }
-            } else if (sensor == "GAS") {
-                bool ok;
-                int gasValue = value.toInt(&ok);
-                if (ok) {
-                    updateGasStatus(gasValue);
-                }
-            } else if (sensor == "FIRE") {
-                bool ok;
-                int fireValue = value.toInt(&ok);
-                if (ok) {
-                    updateFireStatus(fireValue);
-                }
-            } else if (sensor == "PET") {
-                bool poopDetected = (value.toUpper() == "POOP");
-                updatePetStatus(poopDetected);
-            }
-        }
+// 센서 데이터 - 받은 값은 로컬 센서 저장소에도 기록 (DB 가 내려가도 검색 가능)
+void MainWindow::handlePlantEvent(const SensorEvent& event)
+{
+    SensorStore::instance().append(SensorStore::Sensor::Plant, double(event.value));
+    uiScheduler->post(int(UiCard::Plant), int(event.value));
+    ++tcpMessagesProcessed;
+}
+
+void MainWindow::handleGasEvent(const SensorEvent& event)
+{
+    SensorStore::instance().append(SensorStore::Sensor::Gas, double(event.value));
+
+    // 위험 상태로 들어가거나 벗어나는 값은 기다리지 않고 바로 반영
+    const int value = int(event.value);
+    if (isGasDanger(value) != (currentGasStatus == SensorStatus::Danger))
+        uiScheduler->applyNow(int(UiCard::Gas), value);
+    else
+        uiScheduler->post(int(UiCard::Gas), value);
+    ++tcpMessagesProcessed;
+}
+
+void MainWindow::handleFireEvent(const SensorEvent& event)
+{
+    SensorStore::instance().append(SensorStore::Sensor::Fire, double(event.value));
+
+    const int value = int(event.value);
+    if (isFireDanger(value) != (currentFireStatus == SensorStatus::Danger))
+        uiScheduler->applyNow(int(UiCard::Fire), value);
+    else
+        uiScheduler->post(int(UiCard::Fire), value);
+    ++tcpMessagesProcessed;
+}
+
+void MainWindow::handlePetEvent(const SensorEvent& event)
+{
+    bool poopDetected = event.value != 0;
+    SensorStore::instance().append(SensorStore::Sensor::Pet, poopDetected ? 1.0 : 0.0);
+    uiScheduler->post(int(UiCard::Pet), poopDetected ? 1 : 0);
+    ++tcpMessagesProcessed;
+}
+
+void MainWindow::handlePingEvent(const SensorEvent& event)
+{
+    // 부하 시험 서버(smart_home_loadgen)의 지연 측정 - 앞선 메시지를 모두 처리한 뒤에 도착하므로
+    // 지금까지 처리한 센서 메시지 수를 돌려주면 서버가 지연과 누락/병합 수를 계산한다
+    // 마지막 값은 스케줄러가 화면에 반영하지 않고 건너뛴 값 수 (받은 수 - 반영한 수)
+    const quint64 coalesced = uiScheduler->postedCount() - uiScheduler->appliedCount();
+    if (tcpClient)
+        tcpClient->sendMessage(QString("PONG %1 %2 %3\n").arg(event.value).arg(tcpMessagesProcessed).arg(coalesced));
+}
+
+void MainWindow::handleAckEvent(const SensorEvent& event)
+{
+    // 명령 확인 응답: "ACK OPEN", "ACK CLOSE" 등
+    qDebug() << "Server acknowledged command:" << event.textBytes();
+}
+
+void MainWindow::handleServerEvent(const SensorEvent& event)
+{
+    // 이벤트 응답: "EVT OPENED", "EVT CLOSED" 등
+    const QByteArray evt = event.textBytes();
+    qDebug() << "Server event:" << evt;
+
+    if (evt == "OPENED")
+        setWindowOpenState(true);
+    else if (evt == "CLOSED")
+        setWindowOpenState(false);
+}
+
+void MainWindow::handleWindowStatusEvent(const SensorEvent& event)
+{
+    // JSON 상태 응답: {"pose":"OPEN","angle":100,"ts":...} - 파서가 WindowState 로 해석해 둠
+    const WindowState& state = event.window;
+    qDebug() << "Window status:" << int(state.pose) << "angle" << state.angle << "ts" << state.ts;
+
+    // 순서가 뒤바뀌어 늦게 도착한 예전 상태는 무시
+    if (state.ts > 0) {
+        if (state.ts < windowStateTs)
+            return;
+        windowStateTs = state.ts;
     }
+
+    if (state.angle >= 0)
+        windowAngle = state.angle;
+
+    if (state.pose == WindowState::Pose::Unknown)
+        updateWindowLabel();
+    else
+        setWindowOpenState(state.pose == WindowState::Pose::Open);
+}
+
+void MainWindow::handleUnknownEvent(const SensorEvent& event)
+{
+    qDebug() << "[TCP] Unknown message:" << event.textBytes();
+}
+
+void MainWindow::setWindowOpenState(bool open)
+{
+    isWindowOpen = open;
+    if (windowToggle) windowToggle->setChecked(open);
+    updateWindowLabel();
+}
+
+void MainWindow::updateWindowLabel()
+{
+    if (!windowLabel)
+        return;
+
+    // 열려 있고 각도를 알면 함께 표시 ("Open 60°")
+    if (isWindowOpen && windowAngle > 0)
+        windowLabel->setText(QString("Open %1°").arg(windowAngle));
+    else
+        windowLabel->setText(isWindowOpen ? "Open" : "Close");
 }
 
 void MainWindow::onTcpErrorOccurred(const QString& errorString)
@@ -28,6 +28,9 @@
 #include "certified.h"
 #include "search.h"
 #include "tcpclient.h"
+#include "database.h"
+#include "changefeed.h"
+#include "uiupdatescheduler.h"
 
 class CustomToggleSwitch;
 
@@ -42,17 +45,45 @@ enum class SensorStatus {
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
+    friend struct BenchAccess;  // bench/benchaccess.h - private 헬퍼 측정용
 
 public:
     MainWindow(QWidget *parent = nullptr);
 
+    // TCP 접속, DB 연결, 변경 감지 시작 - 생성자는 화면만 만들고 외부 연결은 여기서 시작
+    // (벤치마크는 호출하지 않고 화면/핸들러 경로만 측정)
+    void startServices();
+
+    // 스택 위젯의 페이지 순서
+    enum class Page {
+        Dashboard = 0,
+        Safety,
+        Certified,
+        Search
+    };
+
 public slots:
+    // 아직 만들지 않은 페이지를 이벤트 루프가 한가할 때 하나씩 미리 생성 (--prewarm-pages)
+    void prewarmPages();
+
+    // TCP 센서 값을 카드에 반영하는 최대 빈도 (기본은 화면 주사율, --ui-hz)
+    void setUiUpdateRate(double hz);
+
+    // 연결할 때 바이너리 프레임 협상 시도 여부 (기본은 텍스트만, --binary-protocol)
+    void setBinaryProtocol(bool enabled);
+
+    // 첫 그리기 뒤에 prewarmPages() 를 시작할지 여부 (--prewarm-pages)
+    void setPrewarmPages(bool enabled);
+
     // 센서 데이터 업데이트 슬롯들
     void updatePlantHumidityStatus(int value);
     void updatePetStatus(bool poopDetected);
     void updateGasStatus(int value);
     void updateFireStatus(int value);
 
+protected:
+    void paintEvent(QPaintEvent *event) override;  // 첫 그리기 시점 기록
+
 private slots:
     void toggleWindow();
     void onCameraClicked();
@@ -63,18 +94,61 @@ private slots:
     void toggleGasAlert();
     void updateClock();  // 시계 업데이트 슬롯 추가
     void updateDbData();  // DB 데이터 업데이트 슬롯 추가
+    void connectDatabase();  // DB 비동기 연결 (실패 시 대기 시간을 늘려 재시도)
+
+    // 변경 감지 시 카드별 갱신 슬롯 (sinceId 이후 새 행만 증분 조회)
+    void refreshHomeEnv(qint64 sinceId);
+    void refreshFireStatus(qint64 sinceId);
+    void refreshSoilMoisture(qint64 sinceId);
+    void refreshPetStatus(qint64 sinceId);
 
     // TCP 클라이언트 관련 슬롯
     void onTcpConnected();
     void onTcpDisconnected();
-    void onTcpMessageReceived(const QString& message);
+    void onTcpEvents(const TcpEventBatch& batch);
     void onTcpErrorOccurred(const QString& errorString);
 
 private:
     void setupUI();
     void setupStyles();
     void setupFonts();
-    QTimer *dbUpdateTimer;  // DB 업데이트 타이머 추가
+
+    // 페이지는 처음 이동할 때 생성 (그 전까지 스택에는 빈 자리 표시 위젯)
+    void showPage(Page page);
+    QWidget* ensurePage(Page page);
+    ChangeFeed *changeFeed;  // 센서 테이블 변경 감지 (주기적 전체 조회 대체)
+    bool dbRequestInFlight;  // 비동기 대시보드 조회 응답 대기 중
+    int dbRetryDelayMs;  // 다음 DB 연결 재시도까지 대기 시간
+    bool firstPaintRecorded;
+    quint64 tcpMessagesProcessed;  // 처리한 센서 메시지 수 (부하 시험 PONG 응답용)
+    bool binaryProtocol;  // startServices() 에서 TcpClient 에 전달
+    bool prewarmAfterFirstPaint;  // 첫 paintEvent 에서 prewarmPages() 예약
+
+    // TCP 센서 값은 카드마다 최신 값만 모아 화면 갱신 주기에 한 번 반영 (위험 상태 전환은 즉시)
+    enum class UiCard { Plant, Gas, Fire, Pet };
+    UiUpdateScheduler *uiScheduler;
+    static bool isGasDanger(int value);
+    static bool isFireDanger(int value);
+
+    // 서버 메시지 종류별 처리 함수 - onTcpEvent 가 SensorEvent::Type 으로 바로 찾아 호출
+    void onTcpEvent(const SensorEvent& event);
+    using TcpEventHandler = void (MainWindow::*)(const SensorEvent& event);
+    void handlePlantEvent(const SensorEvent& event);
+    void handleGasEvent(const SensorEvent& event);
+    void handleFireEvent(const SensorEvent& event);
+    void handlePetEvent(const SensorEvent& event);
+    void handlePingEvent(const SensorEvent& event);
+    void handleAckEvent(const SensorEvent& event);
+    void handleServerEvent(const SensorEvent& event);
+    void handleWindowStatusEvent(const SensorEvent& event);
+    void handleUnknownEvent(const SensorEvent& event);
+    void setWindowOpenState(bool open);
+    void updateWindowLabel();
+    void applyDashboardSnapshot(const DashboardSnapshot& snapshot);
+    void applyHomeEnv(const QPair<double, double>& homeEnv);
+    void applyFireStatus(const QPair<QString, QString>& fireInfo);
+    void applySoilMoisture(int soilMoisture);
+    void applyPetToilet(const QString& toiletStatus);
 
     // Layout setup methods
     void setupDashboardLayout(QWidget *dashboardPage);
@@ -113,7 +187,7 @@ private:
     QWidget *headerWidget;
     QWidget *dashboardWidget;
     QWidget *mainCanvas;
-    Safety *safetyWidget;
+    Safety *safetyWidget;        // 처음 이동 전까지 nullptr
     Certified *certifiedWidget;
     Search *searchWidget;
 
@@ -140,6 +214,8 @@ private:
     CustomToggleSwitch *windowToggle;
     QLabel *windowLabel;
     bool isWindowOpen;
+    int windowAngle;        // 서버가 알려 준 열린 각도, 모르면 -1
+    qint64 windowStateTs;   // 마지막으로 반영한 창문 상태 시각 (epoch ms)
 
     // Clock components 추가
     QLabel *clockLabel;
@@ -0,0 +1,124 @@
+#include "profiler.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+{
+    // 프로세스 시작 직후(첫 instance() 호출)부터의 시간
+    m_clock.start();
+}
+
+void Profiler::setEnabled(bool enabled, int capacity)
+{
+    QMutexLocker locker(&m_mutex);
+    if (enabled && m_ring.size() != capacity) {
+        m_ring = QVector<Event>(qMax(1, capacity));
+        m_next = 0;
+        m_wrapped = false;
+    }
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::record(const char* name, qint64 startUs, qint64 durationUs)
+{
+    const quint64 threadId = quint64(quintptr(QThread::currentThreadId()));
+
+    QMutexLocker locker(&m_mutex);
+    if (m_ring.isEmpty())
+        return;
+    m_ring[m_next] = { name, startUs, durationUs, threadId };
+    if (++m_next == m_ring.size()) {
+        m_next = 0;
+        m_wrapped = true;
+    }
+}
+
+QVector<Profiler::Event> Profiler::events() const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_wrapped)
+        return m_ring.mid(0, m_next);
+    return m_ring.mid(m_next) + m_ring.mid(0, m_next);
+}
+
+bool Profiler::writeChromeTrace(const QString& path) const
+{
+    // Trace Event Format - 완료 이벤트("X")만 사용, 시간 단위는 us
+    QJsonArray traceEvents;
+    const qint64 pid = QCoreApplication::applicationPid();
+    for (const Event& event : events()) {
+        QJsonObject object;
+        object["name"] = QString::fromUtf8(event.name);
+        object["ph"] = "X";
+        object["ts"] = event.startUs;
+        object["dur"] = event.durationUs;
+        object["pid"] = pid;
+        object["tid"] = qint64(event.threadId);
+        traceEvents.append(object);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "트레이스 파일 열기 실패:" << path << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+QString Profiler::summary() const
+{
+    struct Stat
+    {
+        QString name;
+        int count = 0;
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+    };
+
+    QHash<QString, Stat> stats;
+    for (const Event& event : events()) {
+        Stat& stat = stats[QString::fromUtf8(event.name)];
+        stat.name = QString::fromUtf8(event.name);
+        ++stat.count;
+        stat.totalUs += event.durationUs;
+        stat.maxUs = qMax(stat.maxUs, event.durationUs);
+    }
+
+    QVector<Stat> sorted(stats.cbegin(), stats.cend());
+    std::sort(sorted.begin(), sorted.end(), [](const Stat& a, const Stat& b) { return a.totalUs > b.totalUs; });
+
+    QString report = QString("%1 %2 %3 %4 %5\n")
+                         .arg(QString("구간"), -40)
+                         .arg(QString("횟수"), 8)
+                         .arg(QString("합계(ms)"), 12)
+                         .arg(QString("평균(ms)"), 10)
+                         .arg(QString("최대(ms)"), 10);
+    for (const Stat& stat : sorted) {
+        report += QString("%1 %2 %3 %4 %5\n")
+                      .arg(stat.name, -40)
+                      .arg(stat.count, 8)
+                      .arg(stat.totalUs / 1000.0, 12, 'f', 2)
+                      .arg(stat.totalUs / 1000.0 / stat.count, 10, 'f', 3)
+                      .arg(stat.maxUs / 1000.0, 10, 'f', 2);
+    }
+    return report;
+}
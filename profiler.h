@@ -0,0 +1,81 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+// 구간 시간 측정 (시작 시간/프레임 시간 회귀 확인용)
+// - PROFILE_SCOPE("이름") 이 스코프를 벗어날 때 걸린 시간을 링 버퍼에 기록 (꺼져 있으면 기록하지 않음)
+// - 버퍼가 차면 가장 오래된 기록부터 덮어쓴다
+// - writeChromeTrace() 로 chrome://tracing / Perfetto 에서 여는 JSON 을, summary() 로 이름별 합계를 만든다
+class Profiler
+{
+public:
+    struct Event
+    {
+        const char* name;       // 문자열 리터럴만 사용 (포인터만 저장)
+        qint64 startUs;         // 프로파일러 시작 기준
+        qint64 durationUs;
+        quint64 threadId;
+    };
+
+    static Profiler& instance();
+
+    void setEnabled(bool enabled, int capacity = 64 * 1024);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+    void record(const char* name, qint64 startUs, qint64 durationUs);
+
+    QVector<Event> events() const;  // 오래된 순
+    bool writeChromeTrace(const QString& path) const;
+    QString summary() const;        // 이름별 횟수/합계/평균/최대 (합계 큰 순)
+
+private:
+    Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    std::atomic<bool> m_enabled { false };
+    QElapsedTimer m_clock;
+    mutable QMutex m_mutex;
+    QVector<Event> m_ring;
+    int m_next = 0;
+    bool m_wrapped = false;
+};
+
+// 스코프 타이머 - 생성부터 소멸까지를 한 구간으로 기록
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(Profiler::instance().isEnabled() ? name : nullptr)
+        , m_startUs(m_name ? Profiler::instance().nowUs() : 0)
+    {
+    }
+
+    ~ProfileScope()
+    {
+        if (m_name) {
+            Profiler& profiler = Profiler::instance();
+            profiler.record(m_name, m_startUs, profiler.nowUs() - m_startUs);
+        }
+    }
+
+private:
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    const char* m_name;
+    qint64 m_startUs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif // PROFILER_H
@@ -0,0 +1,136 @@
+#include "protocol.h"
+#include <QtEndian>
+#include <QList>
+#include <cstring>
+#include <optional>
+
+namespace Protocol {
+
+namespace {
+
+QByteArray encodeInt(FrameType type, qint32 value)
+{
+    char payload[4];
+    qToBigEndian(value, payload);
+    return encodeFrame(type, payload, sizeof(payload));
+}
+
+QByteArray encodePing(quint64 seq)
+{
+    char payload[8];
+    qToBigEndian(seq, payload);
+    return encodeFrame(FrameType::Ping, payload, sizeof(payload));
+}
+
+// coalesced 가 없으면 예전 16바이트 형식
+QByteArray encodePong(quint64 seq, quint64 processed, std::optional<quint64> coalesced)
+{
+    char payload[24];
+    qToBigEndian(seq, payload);
+    qToBigEndian(processed, payload + 8);
+    if (coalesced)
+        qToBigEndian(*coalesced, payload + 16);
+    return encodeFrame(FrameType::Pong, payload, coalesced ? 24 : 16);
+}
+
+} // namespace
+
+DecodeResult decodeFrame(const char* data, qsizetype size, Frame* frame, qsizetype* consumed)
+{
+    if (size < HeaderSize)
+        return DecodeResult::NeedMore;
+
+    const quint32 payloadSize = qFromBigEndian<quint32>(data);
+    if (payloadSize > MaxPayloadSize)
+        return DecodeResult::Invalid;
+    if (size < HeaderSize + qsizetype(payloadSize))
+        return DecodeResult::NeedMore;
+
+    frame->type = FrameType(quint8(data[4]));
+    frame->payload = data + HeaderSize;
+    frame->size = payloadSize;
+    *consumed = HeaderSize + payloadSize;
+    return DecodeResult::Ok;
+}
+
+QByteArray encodeFrame(FrameType type, const char* payload, quint32 size)
+{
+    QByteArray frame(HeaderSize + qsizetype(size), Qt::Uninitialized);
+    qToBigEndian(size, frame.data());
+    frame[4] = char(type);
+    if (size > 0)
+        memcpy(frame.data() + HeaderSize, payload, size);
+    return frame;
+}
+
+QByteArray encodeMessage(const QByteArray& message)
+{
+    const int colon = message.indexOf(':');
+    if (colon > 0) {
+        const QByteArray kind = message.left(colon).toUpper();
+        const QByteArray value = message.mid(colon + 1);
+        bool ok = false;
+        if (kind == "PLANT" || kind == "GAS" || kind == "FIRE") {
+            const int number = value.toInt(&ok);
+            if (ok) {
+                const FrameType type = kind == "PLANT" ? FrameType::Plant
+                                     : kind == "GAS" ? FrameType::Gas : FrameType::Fire;
+                return encodeInt(type, number);
+            }
+        } else if (kind == "PET") {
+            const char poop = value.toUpper() == "POOP" ? 1 : 0;
+            return encodeFrame(FrameType::Pet, &poop, 1);
+        }
+    } else if (message.startsWith("PING ") || message.startsWith("PONG ")) {
+        const QList<QByteArray> parts = message.simplified().split(' ');
+        bool seqOk = false;
+        const quint64 seq = parts.value(1).toULongLong(&seqOk);
+        if (seqOk && parts[0] == "PING")
+            return encodePing(seq);
+        bool processedOk = false;
+        const quint64 processed = parts.value(2).toULongLong(&processedOk);
+        bool coalescedOk = false;
+        const quint64 coalesced = parts.value(3).toULongLong(&coalescedOk);
+        if (seqOk && processedOk)
+            return encodePong(seq, processed, coalescedOk ? std::optional<quint64>(coalesced) : std::nullopt);
+    }
+    return encodeFrame(FrameType::Text, message.constData(), quint32(message.size()));
+}
+
+QByteArray decodeMessage(const Frame& frame)
+{
+    switch (frame.type) {
+    case FrameType::Text:
+        return QByteArray(frame.payload, frame.size);
+    case FrameType::Plant:
+    case FrameType::Gas:
+    case FrameType::Fire: {
+        if (frame.size < 4)
+            break;
+        const char* kind = frame.type == FrameType::Plant ? "PLANT:"
+                         : frame.type == FrameType::Gas ? "GAS:" : "FIRE:";
+        return kind + QByteArray::number(qFromBigEndian<qint32>(frame.payload));
+    }
+    case FrameType::Pet:
+        if (frame.size < 1)
+            break;
+        return frame.payload[0] ? "PET:POOP" : "PET:CLEAN";
+    case FrameType::Ping:
+        if (frame.size < 8)
+            break;
+        return "PING " + QByteArray::number(qFromBigEndian<quint64>(frame.payload));
+    case FrameType::Pong: {
+        if (frame.size < 16)
+            break;
+        QByteArray message = "PONG " + QByteArray::number(qFromBigEndian<quint64>(frame.payload))
+                             + ' ' + QByteArray::number(qFromBigEndian<quint64>(frame.payload + 8));
+        if (frame.size >= 24)
+            message += ' ' + QByteArray::number(qFromBigEndian<quint64>(frame.payload + 16));
+        return message;
+    }
+    }
+    // 모르는 종류는 건너뜀 (새 서버가 보낸 확장 메시지)
+    return QByteArray();
+}
+
+} // namespace Protocol
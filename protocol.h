@@ -0,0 +1,55 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <QByteArray>
+
+// 서버와 주고받는 바이너리 프레임 형식
+// - 프레임: [u32 페이로드 길이 (big endian)][u8 메시지 종류][페이로드]
+//   길이를 먼저 읽으므로 TCP 세그먼트가 합쳐지거나 나뉘어도 경계가 모호하지 않다
+// - 연결 직후 클라이언트가 "HELLO BIN1" 을 보내고, 서버가 "ACK BIN1\n" 으로 답하면 그 뒤부터 양방향 바이너리
+//   답이 없으면 (기존 서버) 기존 텍스트 방식을 그대로 쓴다
+// - 센서 값은 정수/바이트로 줄여 보내고, 그 밖의 메시지(ACK/EVT/JSON/명령)는 Text 프레임에 UTF-8 로 담는다
+namespace Protocol {
+
+enum class FrameType : quint8 {
+    Text  = 0x01,   // UTF-8 텍스트 메시지 (기존 텍스트 프로토콜 한 줄)
+    Plant = 0x10,   // i32 토양 수분
+    Gas   = 0x11,   // i32 가스 값
+    Fire  = 0x12,   // i32 화재 값
+    Pet   = 0x13,   // u8 배변 감지 (1 = POOP)
+    Ping  = 0x30,   // u64 seq
+    Pong  = 0x31,   // u64 seq, u64 처리한 센서 메시지 수 [, u64 화면에 반영하지 않고 건너뛴 값 수]
+};
+
+inline constexpr char HelloBinary[] = "HELLO BIN1";
+inline constexpr char AckBinary[] = "ACK BIN1";
+inline constexpr char BinaryVersion[] = "BIN1";  // AckBinary 의 ACK 뒤 단어
+
+inline constexpr int HeaderSize = 5;
+inline constexpr quint32 MaxPayloadSize = 64 * 1024;  // 이보다 크면 스트림이 깨진 것으로 본다
+
+// 버퍼 안의 프레임을 가리키는 뷰 (payload 는 버퍼가 바뀌기 전까지만 유효)
+struct Frame
+{
+    FrameType type;
+    const char* payload;
+    quint32 size;
+};
+
+enum class DecodeResult {
+    Ok,         // frame 과 consumed 가 채워짐
+    NeedMore,   // 헤더나 페이로드가 아직 다 오지 않음
+    Invalid     // 길이가 비정상 - 연결을 끊고 다시 맺어야 함
+};
+
+DecodeResult decodeFrame(const char* data, qsizetype size, Frame* frame, qsizetype* consumed);
+QByteArray encodeFrame(FrameType type, const char* payload, quint32 size);
+
+// 텍스트 메시지 <-> 프레임 변환
+// "PLANT:42", "PET:POOP", "PING 7" 같은 메시지는 전용 종류로, 나머지는 Text 프레임으로 바꾼다
+QByteArray encodeMessage(const QByteArray& message);
+QByteArray decodeMessage(const Frame& frame);
+
+} // namespace Protocol
+
+#endif // PROTOCOL_H
@@ -0,0 +1,453 @@
+#include "protocolparser.h"
+#include <QtEndian>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QDateTime>
+#include <charconv>
+#include <iterator>
+#include <cstring>
+
+namespace {
+
+const qsizetype kInitialCapacity = 16 * 1024;
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+void trim(const char*& begin, const char*& end)
+{
+    while (begin < end && isSpace(*begin))
+        ++begin;
+    while (end > begin && isSpace(end[-1]))
+        --end;
+}
+
+bool equalsNoCase(const char* begin, const char* end, const char* word)
+{
+    const qsizetype size = qsizetype(strlen(word));
+    return end - begin == size && qstrnicmp(begin, word, size) == 0;
+}
+
+bool parseInt(const char* begin, const char* end, qint64* value)
+{
+    trim(begin, end);
+    if (begin < end && *begin == '+')
+        ++begin;
+    long long parsed = 0;
+    const auto result = std::from_chars(begin, end, parsed);
+    if (result.ec != std::errc() || result.ptr != end || begin == end)
+        return false;
+    *value = parsed;
+    return true;
+}
+
+// 메시지 종류 표 - "PLANT:45" 의 PLANT, "ACK OPEN" 의 ACK 처럼 첫 단어로 종류를 정한다
+// 새 종류는 SensorEvent::Type 과 여기에 한 줄 추가 (해시가 겹치면 컴파일 에러)
+enum class ValueFormat : quint8 {
+    Integer,    // 정수 값
+    PoopFlag,   // "POOP" 이면 1
+    Word        // 뒤따르는 첫 단어를 text 로
+};
+
+struct MessageKind
+{
+    const char* name;
+    SensorEvent::Type type;
+    char separator;     // 종류 이름 뒤 구분 문자
+    ValueFormat format;
+};
+
+constexpr MessageKind kMessageKinds[] = {
+    { "PLANT", SensorEvent::Type::Plant, ':', ValueFormat::Integer },
+    { "GAS",   SensorEvent::Type::Gas,   ':', ValueFormat::Integer },
+    { "FIRE",  SensorEvent::Type::Fire,  ':', ValueFormat::Integer },
+    { "PET",   SensorEvent::Type::Pet,   ':', ValueFormat::PoopFlag },
+    { "PING",  SensorEvent::Type::Ping,  ' ', ValueFormat::Integer },
+    { "ACK",   SensorEvent::Type::Ack,   ' ', ValueFormat::Word },
+    { "EVT",   SensorEvent::Type::Evt,   ' ', ValueFormat::Word },
+};
+
+constexpr int kKindTableSize = 16;
+
+constexpr char toLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c | 0x20) : c;
+}
+
+constexpr qsizetype length(const char* s)
+{
+    qsizetype n = 0;
+    while (s[n])
+        ++n;
+    return n;
+}
+
+// 첫 글자, 마지막 글자, 길이로 만든 완전 해시 (대소문자 무시)
+constexpr int kindHash(const char* s, qsizetype size)
+{
+    return (toLower(s[0]) + toLower(s[size - 1]) * 6 + int(size)) & (kKindTableSize - 1);
+}
+
+struct KindTable
+{
+    qint8 slots[kKindTableSize];
+    bool collision;
+};
+
+constexpr KindTable buildKindTable()
+{
+    KindTable table{};
+    for (int i = 0; i < kKindTableSize; ++i)
+        table.slots[i] = -1;
+    for (int i = 0; i < int(std::size(kMessageKinds)); ++i) {
+        const int h = kindHash(kMessageKinds[i].name, length(kMessageKinds[i].name));
+        if (table.slots[h] >= 0)
+            table.collision = true;
+        table.slots[h] = qint8(i);
+    }
+    return table;
+}
+
+constexpr KindTable kKindTable = buildKindTable();
+static_assert(!kKindTable.collision, "kMessageKinds 해시 충돌 - kindHash 의 계수를 조정할 것");
+
+const MessageKind* findKind(const char* begin, const char* end)
+{
+    if (begin == end)
+        return nullptr;
+    const int slot = kKindTable.slots[kindHash(begin, end - begin)];
+    if (slot < 0)
+        return nullptr;
+    const MessageKind& kind = kMessageKinds[slot];
+    return equalsNoCase(begin, end, kind.name) ? &kind : nullptr;
+}
+
+SensorEvent textEvent(SensorEvent::Type type, const char* begin, const char* end)
+{
+    SensorEvent event;
+    event.type = type;
+    event.value = 0;
+    event.text = begin;
+    event.textSize = int(end - begin);
+    event.window = { WindowState::Pose::Unknown, -1, 0 };
+    return event;
+}
+
+// "ACK OPEN" / "EVT OPENED" 의 첫 단어
+SensorEvent wordEvent(SensorEvent::Type type, const char* begin, const char* end)
+{
+    while (begin < end && isSpace(*begin))
+        ++begin;
+    const char* wordEnd = begin;
+    while (wordEnd < end && !isSpace(*wordEnd))
+        ++wordEnd;
+    return textEvent(type, begin, wordEnd);
+}
+
+// start 의 '{' 와 짝이 맞는 '}' 바로 뒤 위치. 아직 다 오지 않았으면 nullptr
+const char* findObjectEnd(const char* start, const char* end)
+{
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    for (const char* p = start; p < end; ++p) {
+        const char c = *p;
+        if (inString) {
+            if (escaped)
+                escaped = false;
+            else if (c == '\\')
+                escaped = true;
+            else if (c == '"')
+                inString = false;
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if ((c == '}' || c == ']') && --depth == 0) {
+            return p + 1;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+std::optional<WindowState> WindowState::fromJson(const char* data, qsizetype size)
+{
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(data, size), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject())
+        return std::nullopt;
+
+    const QJsonObject object = doc.object();
+    const QJsonValue pose = object.value("pose");
+    const QJsonValue angle = object.value("angle");
+    if (pose.isUndefined() && angle.isUndefined())
+        return std::nullopt;
+
+    WindowState state;
+    const QString poseText = pose.toString().toUpper();
+    if (poseText == "OPEN" || poseText == "OPENED")
+        state.pose = Pose::Open;
+    else if (poseText == "CLOSE" || poseText == "CLOSED")
+        state.pose = Pose::Close;
+    else
+        state.pose = Pose::Unknown;
+
+    state.angle = angle.isDouble() ? angle.toInt() : -1;
+
+    // ts 는 epoch 초/밀리초 숫자 또는 ISO 8601 문자열
+    const QJsonValue ts = object.value("ts");
+    state.ts = 0;
+    if (ts.isDouble()) {
+        const qint64 value = qint64(ts.toDouble());
+        state.ts = value < 100000000000LL ? value * 1000 : value;
+    } else if (ts.isString()) {
+        const QDateTime time = QDateTime::fromString(ts.toString(), Qt::ISODateWithMs);
+        if (time.isValid())
+            state.ts = time.toMSecsSinceEpoch();
+    }
+    return state;
+}
+
+void TcpEventBatch::append(const SensorEvent& event)
+{
+    m_events.append(event);
+    // 센서 값은 text 를 쓰지 않으므로 복사하지 않는다
+    if (event.type >= SensorEvent::Type::Ack) {
+        m_textOffsets.append(int(m_text.size()));
+        m_text.append(event.text, event.textSize);
+    } else {
+        m_textOffsets.append(-1);
+    }
+}
+
+void TcpEventBatch::clear()
+{
+    m_events.clear();
+    m_textOffsets.clear();
+    m_text.clear();
+}
+
+int TcpEventBatch::size() const
+{
+    return int(m_events.size());
+}
+
+bool TcpEventBatch::isEmpty() const
+{
+    return m_events.isEmpty();
+}
+
+SensorEvent TcpEventBatch::at(int index) const
+{
+    SensorEvent event = m_events[index];
+    const int offset = m_textOffsets[index];
+    if (offset >= 0) {
+        event.text = m_text.constData() + offset;
+    } else {
+        event.text = nullptr;
+        event.textSize = 0;
+    }
+    return event;
+}
+
+ProtocolParser::ProtocolParser()
+    : m_begin(0)
+    , m_end(0)
+    , m_mode(Mode::Text)
+    , m_flushPartialLines(true)
+{
+}
+
+void ProtocolParser::setMode(Mode mode)
+{
+    m_mode = mode;
+}
+
+ProtocolParser::Mode ProtocolParser::mode() const
+{
+    return m_mode;
+}
+
+void ProtocolParser::setFlushPartialLines(bool enabled)
+{
+    m_flushPartialLines = enabled;
+}
+
+char* ProtocolParser::reserve(qsizetype size)
+{
+    if (m_end + size > m_buffer.size()) {
+        // 이미 해석한 앞부분을 버리고 남은 데이터를 앞으로 당김
+        if (m_begin > 0) {
+            memmove(m_buffer.data(), m_buffer.constData() + m_begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+        if (m_end + size > m_buffer.size())
+            m_buffer.resize(qMax(qMax(kInitialCapacity, m_buffer.size() * 2), m_end + size));
+    }
+    return m_buffer.data() + m_end;
+}
+
+void ProtocolParser::commit(qsizetype size)
+{
+    m_end += size;
+}
+
+void ProtocolParser::append(const char* data, qsizetype size)
+{
+    memcpy(reserve(size), data, size);
+    commit(size);
+}
+
+void ProtocolParser::clear()
+{
+    m_begin = m_end = 0;
+}
+
+qsizetype ProtocolParser::pendingBytes() const
+{
+    return m_end - m_begin;
+}
+
+qsizetype ProtocolParser::next(SensorEvent* event, bool* hasEvent) const
+{
+    const char* begin = m_buffer.constData() + m_begin;
+    const qsizetype available = m_end - m_begin;
+
+    if (m_mode == Mode::Binary) {
+        Protocol::Frame frame;
+        qsizetype consumed = 0;
+        switch (Protocol::decodeFrame(begin, available, &frame, &consumed)) {
+        case Protocol::DecodeResult::NeedMore:
+            return 0;
+        case Protocol::DecodeResult::Invalid:
+            return -1;
+        case Protocol::DecodeResult::Ok:
+            *hasEvent = parseFrame(frame, event);
+            return consumed;
+        }
+        return -1;
+    }
+
+    // 메시지 사이 공백/빈 줄은 건너뜀
+    const char* start = begin;
+    const char* bufferEnd = begin + available;
+    while (start < bufferEnd && isSpace(*start))
+        ++start;
+    if (start == bufferEnd)
+        return available;
+
+    if (*start == '{') {
+        // JSON 객체는 개행과 상관없이 짝이 맞는 '}' 까지 한 건
+        const char* objectEnd = findObjectEnd(start, bufferEnd);
+        if (!objectEnd)
+            return available > qsizetype(Protocol::MaxPayloadSize) ? -1 : 0;
+        *event = parseJson(start, objectEnd - start);
+        *hasEvent = true;
+        return objectEnd - begin;
+    }
+
+    const char* newline = static_cast<const char*>(memchr(start, '\n', bufferEnd - start));
+    if (!newline && !m_flushPartialLines)
+        return 0;
+
+    const char* end = newline ? newline : bufferEnd;
+    const char* lineBegin = start;
+    const char* lineEnd = end;
+    trim(lineBegin, lineEnd);
+    if (lineBegin < lineEnd) {
+        *event = parseLine(lineBegin, lineEnd - lineBegin);
+        *hasEvent = true;
+    }
+    return newline ? (newline - begin) + 1 : available;
+}
+
+SensorEvent ProtocolParser::parseLine(const char* data, qsizetype size)
+{
+    const char* begin = data;
+    const char* end = data + size;
+    trim(begin, end);
+
+    if (begin < end && *begin == '{' && end[-1] == '}')
+        return parseJson(begin, end - begin);
+
+    // 첫 단어 ("PLANT:45" 의 PLANT, "ACK OPEN" 의 ACK) 로 종류를 찾고 나머지를 값으로 해석
+    const char* wordEnd = begin;
+    while (wordEnd < end && *wordEnd != ':' && !isSpace(*wordEnd))
+        ++wordEnd;
+
+    const MessageKind* kind = findKind(begin, wordEnd);
+    if (!kind || (wordEnd < end && *wordEnd != kind->separator))
+        return textEvent(SensorEvent::Type::Text, begin, end);
+
+    const char* valueBegin = wordEnd < end ? wordEnd + 1 : end;
+    const char* valueEnd = end;
+    trim(valueBegin, valueEnd);
+
+    SensorEvent event = textEvent(kind->type, begin, end);
+    switch (kind->format) {
+    case ValueFormat::Integer:
+        if (!parseInt(valueBegin, valueEnd, &event.value))
+            event.type = SensorEvent::Type::Text;
+        break;
+    case ValueFormat::PoopFlag:
+        event.value = equalsNoCase(valueBegin, valueEnd, "POOP") ? 1 : 0;
+        break;
+    case ValueFormat::Word:
+        return wordEvent(kind->type, valueBegin, valueEnd);
+    }
+    return event;
+}
+
+SensorEvent ProtocolParser::parseJson(const char* data, qsizetype size)
+{
+    const std::optional<WindowState> window = WindowState::fromJson(data, size);
+    SensorEvent event = textEvent(window ? SensorEvent::Type::WindowStatus : SensorEvent::Type::Json,
+                                  data, data + size);
+    if (window)
+        event.window = *window;
+    return event;
+}
+
+bool ProtocolParser::parseFrame(const Protocol::Frame& frame, SensorEvent* event)
+{
+    using Protocol::FrameType;
+
+    *event = textEvent(SensorEvent::Type::Text, frame.payload, frame.payload);
+
+    switch (frame.type) {
+    case FrameType::Text:
+        *event = parseLine(frame.payload, frame.size);
+        return true;
+    case FrameType::Plant:
+    case FrameType::Gas:
+    case FrameType::Fire:
+        if (frame.size < 4)
+            return false;
+        event->type = frame.type == FrameType::Plant ? SensorEvent::Type::Plant
+                    : frame.type == FrameType::Gas ? SensorEvent::Type::Gas : SensorEvent::Type::Fire;
+        event->value = qFromBigEndian<qint32>(frame.payload);
+        return true;
+    case FrameType::Pet:
+        if (frame.size < 1)
+            return false;
+        event->type = SensorEvent::Type::Pet;
+        event->value = frame.payload[0] ? 1 : 0;
+        return true;
+    case FrameType::Ping:
+        if (frame.size < 8)
+            return false;
+        event->type = SensorEvent::Type::Ping;
+        event->value = qint64(qFromBigEndian<quint64>(frame.payload));
+        return true;
+    case FrameType::Pong:
+        break;  // 서버 -> 클라이언트 방향에는 없음
+    }
+    // 모르는 종류는 건너뜀 (새 서버가 보낸 확장 메시지)
+    return false;
+}
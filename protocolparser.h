@@ -0,0 +1,147 @@
+#ifndef PROTOCOLPARSER_H
+#define PROTOCOLPARSER_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QMetaType>
+#include <optional>
+#include "protocol.h"
+
+// 창문 상태 응답 ({"pose":"OPEN","angle":100,"ts":1700000000000}) 을 해석한 값
+struct WindowState
+{
+    enum class Pose : quint8 { Unknown, Open, Close };
+
+    Pose pose;
+    int angle;      // 열린 각도, 없으면 -1
+    qint64 ts;      // 서버가 상태를 잰 시각 (epoch ms), 없으면 0
+
+    // pose/angle 이 하나도 없는 JSON 이면 nullopt
+    static std::optional<WindowState> fromJson(const char* data, qsizetype size);
+};
+
+// 서버 메시지 한 건을 해석한 결과 (복사 비용이 없는 POD)
+// text 는 ProtocolParser 버퍼 안을 가리키므로 콜백 안에서만 유효 - 보관하려면 textBytes() 를 복사할 것
+struct SensorEvent
+{
+    enum class Type : quint8 {
+        Plant,  // value = 토양 수분
+        Gas,    // value = 가스 값
+        Fire,   // value = 화재 값
+        Pet,    // value = 1 이면 배변 감지
+        Ping,   // value = seq (부하 시험 서버)
+        // 여기부터는 드물게 오는 텍스트 응답
+        Ack,    // text = 확인된 명령 ("OPEN" 등)
+        Evt,    // text = 이벤트 ("OPENED" 등)
+        WindowStatus,   // window = 창문 상태, text = JSON 원문
+        Json,   // text = 창문 상태가 아닌 JSON 원문
+        Text,   // text = 해석하지 못한 메시지 원문
+        Count
+    };
+
+    Type type;
+    qint64 value;
+    const char* text;
+    int textSize;
+    WindowState window;
+
+    QByteArray textBytes() const { return QByteArray::fromRawData(text, textSize); }
+};
+
+// 네트워크 스레드에서 GUI 스레드로 한 번에 넘기는 이벤트 묶음
+// 텍스트 응답(Ack 이후 종류)의 text 는 묶음 안 버퍼로 복사해 두므로 파서 버퍼가 바뀌어도 유효
+class TcpEventBatch
+{
+public:
+    void append(const SensorEvent& event);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const;
+
+    // text 는 이 묶음이 살아 있는 동안 유효
+    SensorEvent at(int index) const;
+
+private:
+    QVector<SensorEvent> m_events;
+    QVector<int> m_textOffsets;
+    QByteArray m_text;
+};
+
+Q_DECLARE_METATYPE(TcpEventBatch)
+
+// 수신 스트림 파서
+// - 소켓에서 재사용 버퍼 끝에 바로 읽어 넣고 (reserve/commit), 완성된 줄/프레임을 버퍼 안에서 바로 해석
+// - 소비한 앞부분은 다음 reserve 때 한 번에 앞으로 당기므로 메시지마다 할당/복사가 없다
+// - 텍스트 모드는 개행 단위, 바이너리 모드는 protocol.h 프레임 단위
+//   단 '{' 로 시작하면 중괄호 깊이로 JSON 객체 끝을 찾으므로 여러 줄/세그먼트에 걸친 객체도 한 건이 된다
+class ProtocolParser
+{
+public:
+    enum class Mode { Text, Binary };
+
+    ProtocolParser();
+
+    void setMode(Mode mode);
+    Mode mode() const;
+
+    // 개행 없이 끝난 나머지를 한 메시지로 볼지 (기존 서버는 개행 없이 보냄, 기본 true)
+    void setFlushPartialLines(bool enabled);
+
+    // 버퍼 끝에 최소 size 바이트 자리를 만들어 돌려줌. 실제로 쓴 만큼 commit
+    char* reserve(qsizetype size);
+    void commit(qsizetype size);
+    void append(const char* data, qsizetype size);
+
+    // 완성된 메시지마다 onEvent(const SensorEvent&) 호출
+    // 콜백 안에서 setMode 로 바꾸면 남은 데이터부터 새 방식으로 읽는다
+    // 바이너리 프레임 길이가 비정상이면 버퍼를 비우고 false
+    template <typename Fn>
+    bool parse(Fn&& onEvent);
+
+    void clear();
+    qsizetype pendingBytes() const;
+
+    // 텍스트 메시지 한 건 해석 (앞뒤 공백은 무시)
+    static SensorEvent parseLine(const char* data, qsizetype size);
+    // JSON 객체 한 건 해석 - 창문 상태면 WindowStatus, 아니면 Json
+    static SensorEvent parseJson(const char* data, qsizetype size);
+    // 바이너리 프레임 한 건 해석. 모르는 종류면 false
+    static bool parseFrame(const Protocol::Frame& frame, SensorEvent* event);
+
+private:
+    // 버퍼 앞의 메시지 하나를 해석. 소비한 바이트 수 (0 = 데이터 부족, -1 = 잘못된 프레임)
+    qsizetype next(SensorEvent* event, bool* hasEvent) const;
+
+    QByteArray m_buffer;
+    qsizetype m_begin;   // 아직 해석하지 않은 데이터 시작
+    qsizetype m_end;     // 받은 데이터 끝
+    Mode m_mode;
+    bool m_flushPartialLines;
+};
+
+template <typename Fn>
+bool ProtocolParser::parse(Fn&& onEvent)
+{
+    while (m_begin < m_end) {
+        SensorEvent event;
+        bool hasEvent = false;
+        const qsizetype consumed = next(&event, &hasEvent);
+        if (consumed < 0) {
+            clear();
+            return false;
+        }
+        if (consumed == 0)
+            break;
+
+        m_begin += consumed;
+        if (hasEvent)
+            onEvent(event);
+    }
+
+    if (m_begin == m_end)
+        m_begin = m_end = 0;
+    return true;
+}
+
+#endif // PROTOCOLPARSER_H
@@ -1,4 +1,5 @@
 #include "safety.h"
+#include "profiler.h"
 
 //=============================================================================
 // COLOR CONSTANTS - Match Main Dashboard
@@ -17,6 +18,7 @@ namespace {
 
 Safety::Safety(QWidget *parent) : QWidget(parent), isEmergencyCallActive(false), isFireAlarmActive(false)
 {
+    PROFILE_SCOPE("Safety::Safety");
     setupFonts();
     setupUI();
     setupStyles();
@@ -0,0 +1,185 @@
+#include "schemamigrator.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QDebug>
+
+namespace {
+
+// MySQL: 이미 같은 이름의 인덱스가 있음 (수동으로 만든 경우) - 적용된 것으로 간주
+const QString kDuplicateKeyName = QStringLiteral("1061");
+
+// EXPLAIN 으로 확인할 대표 쿼리 - database.cpp 의 검색/최신 값 쿼리와 같은 모양을 유지할 것
+struct PlanCheck
+{
+    const char* name;
+    const char* sql;
+};
+
+const PlanCheck kPlanChecks[] = {
+    { "searchPageHome",
+      "SELECT id, temperature, humidity, illumination, measured_at FROM home_env "
+      "WHERE home_id = '1' AND measured_at >= FROM_UNIXTIME(946684800) AND measured_at <= FROM_UNIXTIME(946771200) "
+      "AND (measured_at < FROM_UNIXTIME(946771200) OR (measured_at = FROM_UNIXTIME(946771200) AND id < 1000)) "
+      "ORDER BY measured_at DESC, id DESC LIMIT 501" },
+    { "searchPageFire",
+      "SELECT id, fire_status, fire_level, detected_at FROM fire_events "
+      "WHERE home_id = '1' AND detected_at >= FROM_UNIXTIME(946684800) AND detected_at <= FROM_UNIXTIME(946771200) "
+      "AND (detected_at < FROM_UNIXTIME(946771200) OR (detected_at = FROM_UNIXTIME(946771200) AND id < 1000)) "
+      "ORDER BY detected_at DESC, id DESC LIMIT 501" },
+    { "searchPageGas",
+      "SELECT id, level_status, level, detected_at FROM fire_events "
+      "WHERE home_id = '1' AND detected_at >= FROM_UNIXTIME(946684800) AND detected_at <= FROM_UNIXTIME(946771200) "
+      "AND (detected_at < FROM_UNIXTIME(946771200) OR (detected_at = FROM_UNIXTIME(946771200) AND id < 1000)) "
+      "ORDER BY detected_at DESC, id DESC LIMIT 501" },
+    { "searchPagePlant",
+      "SELECT id, soil_moisture, measured_at FROM plant_env "
+      "WHERE home_id = '1' AND measured_at >= FROM_UNIXTIME(946684800) AND measured_at <= FROM_UNIXTIME(946771200) "
+      "AND (measured_at < FROM_UNIXTIME(946771200) OR (measured_at = FROM_UNIXTIME(946771200) AND id < 1000)) "
+      "ORDER BY measured_at DESC, id DESC LIMIT 501" },
+    { "searchPagePet",
+      "SELECT id, food, water, toilet, measured_at FROM pet_status "
+      "WHERE home_id = '1' AND measured_at >= FROM_UNIXTIME(946684800) AND measured_at <= FROM_UNIXTIME(946771200) "
+      "AND (measured_at < FROM_UNIXTIME(946771200) OR (measured_at = FROM_UNIXTIME(946771200) AND id < 1000)) "
+      "ORDER BY measured_at DESC, id DESC LIMIT 501" },
+    { "latestHomeEnv",
+      "SELECT temperature, humidity FROM home_env WHERE home_id = '1' AND id > 0 ORDER BY id DESC LIMIT 1" },
+    { "latestFireStatus",
+      "SELECT fire_status, level_status FROM fire_events WHERE home_id = '1' AND id > 0 ORDER BY id DESC LIMIT 1" },
+    { "latestSoilMoisture",
+      "SELECT soil_moisture FROM plant_env WHERE home_id = '1' AND id > 0 ORDER BY id DESC LIMIT 1" },
+    { "latestPetToilet",
+      "SELECT toilet FROM pet_status WHERE home_id = '1' AND id > 0 ORDER BY id DESC LIMIT 1" },
+};
+
+} // namespace
+
+SchemaMigrator::SchemaMigrator(const QSqlDatabase& db)
+    : m_db(db)
+{
+}
+
+const QVector<SchemaMigrator::Migration>& SchemaMigrator::migrations()
+{
+    // 버전은 1부터 증가만 한다. 이미 배포된 마이그레이션은 수정하지 말고 새 버전을 추가할 것
+    static const QVector<Migration> list = {
+        { 1, "검색용 (home_id, 시각) 커버링 인덱스", {
+              "CREATE INDEX idx_home_env_home_time "
+              "ON home_env (home_id, measured_at, temperature, humidity, illumination)",
+              "CREATE INDEX idx_fire_events_home_time "
+              "ON fire_events (home_id, detected_at, fire_status, fire_level, level_status, level)",
+              "CREATE INDEX idx_plant_env_home_time "
+              "ON plant_env (home_id, measured_at, soil_moisture)",
+              "CREATE INDEX idx_pet_status_home_time "
+              "ON pet_status (home_id, measured_at, food, water, toilet)",
+          } },
+        { 2, "최신 값 조회용 (home_id, id) 커버링 인덱스", {
+              "CREATE INDEX idx_home_env_home_id ON home_env (home_id, id, temperature, humidity)",
+              "CREATE INDEX idx_fire_events_home_id ON fire_events (home_id, id, fire_status, level_status)",
+              "CREATE INDEX idx_plant_env_home_id ON plant_env (home_id, id, soil_moisture)",
+              "CREATE INDEX idx_pet_status_home_id ON pet_status (home_id, id, toilet)",
+              "CREATE INDEX idx_door_status_home_id ON door_status (home_id, id, status)",
+          } },
+    };
+    return list;
+}
+
+int SchemaMigrator::latestVersion()
+{
+    return migrations().isEmpty() ? 0 : migrations().last().version;
+}
+
+bool SchemaMigrator::ensureVersionTable()
+{
+    QSqlQuery query(m_db);
+    if (!query.exec("CREATE TABLE IF NOT EXISTS schema_version ("
+                    " version INT NOT NULL PRIMARY KEY,"
+                    " description VARCHAR(255) NOT NULL,"
+                    " applied_at DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP)")) {
+        qWarning() << "schema_version 테이블 생성 실패:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+int SchemaMigrator::currentVersion()
+{
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT COALESCE(MAX(version), 0) FROM schema_version") || !query.next())
+        return 0;
+    return query.value(0).toInt();
+}
+
+bool SchemaMigrator::migrate()
+{
+    if (!ensureVersionTable())
+        return false;
+
+    const int current = currentVersion();
+    for (const Migration& migration : migrations()) {
+        if (migration.version <= current)
+            continue;
+        if (!apply(migration))
+            return false;
+    }
+    return true;
+}
+
+bool SchemaMigrator::apply(const Migration& migration)
+{
+    qDebug() << "스키마 마이그레이션 적용:" << migration.version << migration.description;
+
+    // MySQL 의 DDL 은 트랜잭션으로 묶이지 않으므로, 문장별로 실행하고
+    // 이미 있는 인덱스는 건너뛰어 중간에 실패한 마이그레이션도 다시 실행할 수 있게 한다
+    QSqlQuery query(m_db);
+    for (const QString& statement : migration.statements) {
+        if (query.exec(statement))
+            continue;
+        if (query.lastError().nativeErrorCode() == kDuplicateKeyName)
+            continue;
+        qWarning() << "마이그레이션" << migration.version << "실패:" << query.lastError().text();
+        return false;
+    }
+
+    query.prepare("INSERT INTO schema_version (version, description) VALUES (?, ?)");
+    query.bindValue(0, migration.version);
+    query.bindValue(1, migration.description);
+    if (!query.exec()) {
+        qWarning() << "schema_version 기록 실패:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+int SchemaMigrator::verifyQueryPlans()
+{
+    int fullScans = 0;
+    QSqlQuery query(m_db);
+
+    for (const PlanCheck& check : kPlanChecks) {
+        if (!query.exec(QString("EXPLAIN ") + check.sql)) {
+            qWarning() << "EXPLAIN 실패:" << check.name << query.lastError().text();
+            continue;
+        }
+
+        const QSqlRecord record = query.record();
+        const int typeCol = record.indexOf("type");
+        const int keyCol = record.indexOf("key");
+        const int extraCol = record.indexOf("Extra");
+
+        while (query.next()) {
+            const QString type = query.value(typeCol).toString();
+            const QString key = query.value(keyCol).toString();
+            const QString extra = query.value(extraCol).toString();
+
+            // type=ALL 은 테이블 전체 스캔, filesort 는 인덱스 순서를 못 써서 결과를 다시 정렬함
+            if (type == "ALL") {
+                qWarning() << "전체 스캔 예상:" << check.name << "type=" << type << extra;
+                ++fullScans;
+            } else if (extra.contains("filesort")) {
+                qWarning() << "정렬에 인덱스 미사용:" << check.name << "key=" << key << extra;
+            }
+        }
+    }
+    return fullScans;
+}
@@ -0,0 +1,44 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 스키마 버전 관리 / 인덱스 마이그레이션
+// - schema_version 테이블에 적용된 버전을 기록하고, 그보다 높은 마이그레이션만 순서대로 적용
+// - 검색(home_id, 시각 범위)과 최신 값 조회(home_id, id)용 커버링 인덱스를 만든다
+// - verifyQueryPlans() 는 주요 쿼리를 EXPLAIN 해서 풀스캔/filesort 가 보이면 경고를 남긴다
+class SchemaMigrator
+{
+public:
+    explicit SchemaMigrator(const QSqlDatabase& db);
+
+    // 미적용 마이그레이션 적용. 하나라도 실패하면 그 지점에서 멈추고 false
+    bool migrate();
+
+    // 현재 DB 에 기록된 스키마 버전 (schema_version 이 없으면 0)
+    int currentVersion();
+    static int latestVersion();
+
+    // 검색/최신 값 쿼리의 실행 계획 확인. 풀스캔이 예상되는 쿼리 수를 반환
+    int verifyQueryPlans();
+
+private:
+    struct Migration
+    {
+        int version;
+        QString description;
+        QStringList statements;
+    };
+
+    static const QVector<Migration>& migrations();
+
+    bool ensureVersionTable();
+    bool apply(const Migration& migration);
+
+    QSqlDatabase m_db;
+};
+
+#endif // SCHEMAMIGRATOR_H
@@ -3,6 +3,12 @@
 #include <QScreen>
 #include <QApplication>
 #include <QDebug>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <limits>
+#include "sensorstore.h"
+#include "searchexport.h"
+#include "profiler.h"
 
 // 색상 상수들 (다른 파일들과 동일)
 const QColor BackgroundGray(0xEA, 0xE6, 0xE6);
@@ -11,8 +17,121 @@ const QColor CardWhite(0xFF, 0xFF, 0xFF);
 const QColor StatusGray(0xF5, 0xF5, 0xF5);
 const QColor CameraAreaGray(0xE8, 0xE8, 0xE8);
 
-Search::Search(QWidget *parent) : QWidget(parent)
+// 한 번에 가져오는 검색 행 수
+static const int SearchPageSize = 500;
+// 조회 대상 집 (대시보드와 동일)
+static const QString SearchHomeId = QStringLiteral("1");
+// DB 없이 로컬 센서 기록에서 한 번에 보여줄 최대 행 수
+static const int LocalSearchLimit = 100000;
+// 내보내기는 화면 표시와 달리 범위 전체를 읽으므로 페이지를 크게
+static const int ExportPageSize = 5000;
+
+// 시각 내림차순 결과에서 마지막 행과 같은 시각의 행만
+// 같은 시각의 행이 다음 페이지로 이어질 수 있으므로 이 행들은 다음 페이지와 함께 캐시에 기록한다
+static SearchColumns rowsAtBottom(const SearchColumns& columns)
 {
+    SearchColumns result = columns;
+    std::visit([&](auto& out) {
+        using Columns = std::decay_t<decltype(out)>;
+        const Columns& page = std::get<Columns>(columns);
+        out = Columns();
+        int begin = page.size();
+        while (begin > 0 && page.ts[begin - 1] == page.ts.last())
+            --begin;
+        for (int i = begin; i < page.size(); ++i)
+            out.appendRow(page, i);
+    }, result);
+    return result;
+}
+
+// head 뒤에 tail 을 이어 붙인 결과 (종류가 다르면 tail 만)
+static SearchColumns concatColumns(const SearchColumns& head, const SearchColumns& tail)
+{
+    if (head.index() != tail.index())
+        return tail;
+    SearchColumns result = head;
+    std::visit([&](auto& out) { out.append(std::get<std::decay_t<decltype(out)>>(tail)); }, result);
+    return result;
+}
+
+// DB 가 내려가 있을 때 로컬 센서 저장소에서 같은 모양의 검색 결과를 만든다
+// 로컬 기록은 TCP 로 받은 원본 수치만 있으므로 상태 문자열은 수치로부터 정하지 않는다
+static SearchPage localSearchPage(SearchCategory category, qint64 firstMs, qint64 lastMs)
+{
+    SearchPage page;
+    page.category = category;
+    SensorStore& store = SensorStore::instance();
+
+    switch (category) {
+    case SearchCategory::HomeEnv:
+        // 온습도는 TCP 로 들어오지 않아 로컬 기록이 없음
+        page.columns = HomeEnvColumns();
+        break;
+    case SearchCategory::Fire:
+    case SearchCategory::Gas: {
+        const SensorStore::Sensor sensor = category == SearchCategory::Fire ? SensorStore::Sensor::Fire
+                                                                            : SensorStore::Sensor::Gas;
+        const QVector<SensorStore::Record> records = store.query(sensor, firstMs, lastMs, LocalSearchLimit);
+        EventColumns events;
+        events.reserve(records.size());
+        const quint16 status = events.statusNames.intern("로컬 기록");
+        for (const SensorStore::Record& record : records) {
+            events.ts.append(record.tsMs);
+            events.status.append(status);
+            events.level.append(static_cast<float>(record.value));
+        }
+        page.columns = events;
+        break;
+    }
+    case SearchCategory::Plant: {
+        const QVector<SensorStore::Record> records = store.query(SensorStore::Sensor::Plant, firstMs, lastMs, LocalSearchLimit);
+        PlantColumns plant;
+        plant.reserve(records.size());
+        for (const SensorStore::Record& record : records) {
+            plant.ts.append(record.tsMs);
+            plant.soilMoisture.append(static_cast<int>(record.value));
+        }
+        page.columns = plant;
+        break;
+    }
+    case SearchCategory::Pet: {
+        const QVector<SensorStore::Record> records = store.query(SensorStore::Sensor::Pet, firstMs, lastMs, LocalSearchLimit);
+        PetColumns pet;
+        pet.reserve(records.size());
+        const quint16 unknown = pet.names.intern("-");
+        const quint16 poop = pet.names.intern("배변 감지");
+        const quint16 clean = pet.names.intern("정상");
+        for (const SensorStore::Record& record : records) {
+            pet.ts.append(record.tsMs);
+            pet.food.append(unknown);
+            pet.water.append(unknown);
+            pet.toilet.append(record.value > 0.5 ? poop : clean);
+        }
+        page.columns = pet;
+        break;
+    }
+    }
+    return page;
+}
+
+Search::Search(QWidget *parent)
+    : QWidget(parent)
+    , searchGeneration(0)
+    , initialSearchDone(false)
+    , searchCategory(SearchCategory::HomeEnv)
+    , searchStart(0)
+    , searchEnd(0)
+    , searchSpanIndex(0)
+    , searchSpanTop(0)
+    , searchCacheEpoch(0)
+    , searchHasMore(false)
+    , pageRequestInFlight(false)
+    , exportGeneration(0)
+    , exportCategory(SearchCategory::HomeEnv)
+    , exportStart(0)
+    , exportEnd(0)
+{
+    PROFILE_SCOPE("Search::Search");
     setupFonts();
     setupUI();
     setupStyles();
@@ -120,6 +239,16 @@ void Search::createSearchControls(QVBoxLayout *leftLayout)
     categoryComboBox->setFixedSize(150, 40);
     categoryComboBox->addItems({"온도", "화재", "가스", "식물", "펫"});
 
+    // 집계 단위 콤보박스 - 긴 기간은 구간별 min/avg/max 로 줄여서 조회 (카테고리와 같은 스타일)
+    aggregationComboBox = new QComboBox();
+    aggregationComboBox->setObjectName("categoryComboBox");
+    aggregationComboBox->setFixedSize(110, 40);
+    aggregationComboBox->addItem("자동", -1);
+    aggregationComboBox->addItem("원본", static_cast<int>(SearchBucket::Raw));
+    aggregationComboBox->addItem("분", static_cast<int>(SearchBucket::Minute));
+    aggregationComboBox->addItem("시간", static_cast<int>(SearchBucket::Hour));
+    aggregationComboBox->addItem("일", static_cast<int>(SearchBucket::Day));
+
     // 시작일시 - QDateTimeEdit으로 변경
     startDateTimeEdit = new QDateTimeEdit();
     startDateTimeEdit->setObjectName("dateTimeEdit");
@@ -147,31 +276,36 @@ void Search::createSearchControls(QVBoxLayout *leftLayout)
     searchButton->setObjectName("searchButton");
     searchButton->setFixedSize(100, 40);
 
+    // 내보내기 버튼 - 조회 범위 원본을 압축 파일로 저장
+    exportButton = new QPushButton("내보내기");
+    exportButton->setObjectName("searchButton");
+    exportButton->setFixedSize(100, 40);
+
     controlsLayout->addWidget(categoryComboBox);
+    controlsLayout->addWidget(aggregationComboBox);
     controlsLayout->addWidget(startDateTimeEdit);
     controlsLayout->addWidget(dashLabel);
     controlsLayout->addWidget(endDateTimeEdit);
     controlsLayout->addWidget(searchButton);
+    controlsLayout->addWidget(exportButton);
     controlsLayout->addStretch();
 
     // 시그널 연결
     connect(searchButton, &QPushButton::clicked, this, &Search::onSearchClicked);
+    connect(exportButton, &QPushButton::clicked, this, &Search::onExportClicked);
     connect(categoryComboBox, &QComboBox::currentTextChanged, this, &Search::onCategoryChanged);
+    connect(aggregationComboBox, &QComboBox::currentIndexChanged, this, &Search::onSearchClicked);
 
     leftLayout->addWidget(searchControlsWidget);
 }
 
 void Search::createSearchTable(QVBoxLayout *leftLayout)
 {
-    // 테이블 위젯 생성
-    resultsTable = new QTableWidget();
+    // 테이블 뷰 + 모델 생성 (헤더는 모델이 제공)
+    resultsModel = new SearchTableModel(this);
+    resultsTable = new QTableView();
     resultsTable->setObjectName("resultsTable");
-    resultsTable->setColumnCount(3);
-
-    // 테이블 헤더 설정
-    QStringList headers;
-    headers << "날짜" << "분류" << "값";
-    resultsTable->setHorizontalHeaderLabels(headers);
+    resultsTable->setModel(resultsModel);
 
     // 테이블 스타일 설정
     resultsTable->horizontalHeader()->setStretchLastSection(true);
@@ -188,11 +322,24 @@ void Search::createSearchTable(QVBoxLayout *leftLayout)
     resultsTable->setAlternatingRowColors(true);
     resultsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     resultsTable->verticalHeader()->setVisible(false);
+    // 모든 행의 높이가 같으므로 행마다 크기를 계산하지 않도록 고정
+    resultsTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+    // 스크롤이 끝에 닿아 뷰가 fetchMore 를 호출하면 다음 페이지 요청
+    connect(resultsModel, &SearchTableModel::moreRequested, this, &Search::requestNextPage);
 
     leftLayout->addWidget(resultsTable, 1);
 
-    // 초기 데이터 로드
-    loadSearchData();
+    // 초기 데이터는 페이지가 처음 보일 때 로드 (앱 시작 시 DB 조회를 기다리지 않도록)
+}
+
+void Search::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (!initialSearchDone) {
+        initialSearchDone = true;
+        loadSearchData();
+    }
 }
 
 void Search::createControlButtons(QHBoxLayout *mainLayout)
@@ -240,201 +387,229 @@ void Search::onCategoryChanged(const QString& category)
 
 void Search::loadSearchData()
 {
-    // yyyy-MM-dd HH:mm:ss 형식으로 변경
-    QString startDateTime = startDateTimeEdit->dateTime().toString("yyyy-MM-dd hh:mm:ss");
-    QString endDateTime = endDateTimeEdit->dateTime().toString("yyyy-MM-dd hh:mm:ss");
-    QString category = categoryComboBox->currentText();
-
-    clearTable();
-
-    if (category == "온도") {
-        populateHomeData(startDateTime, endDateTime);
-    } else if (category == "화재") {
-        populateFireData(startDateTime, endDateTime);
-    } else if (category == "가스") {
-        populateGasData(startDateTime, endDateTime);
-    } else if (category == "식물") {
-        populatePlantData(startDateTime, endDateTime);
-    } else if (category == "펫") {
-        populatePetData(startDateTime, endDateTime);
+    PROFILE_SCOPE("Search::loadSearchData");
+    // 응답이 늦게 도착한 이전 검색 결과는 버리기 위한 세대 번호
+    ++searchGeneration;
+
+    // 검색 범위는 epoch ms 로 전달
+    searchStart = startDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    searchEnd = endDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    // 콤보박스 항목 순서가 SearchCategory 순서와 같음
+    searchCategory = static_cast<SearchCategory>(categoryComboBox->currentIndex());
+    searchCursor = SearchCursor();
+    pageRequestInFlight = false;
+
+    // DB 없이 동작 중이면 로컬 센서 기록에서 바로 조회 (집계 없이 원본)
+    if (!Database::instance().isConnected()) {
+        searchHasMore = false;
+        resultsModel->reset(searchCategory);
+        resultsModel->appendPage(localSearchPage(searchCategory, searchStart, searchEnd));
+        return;
     }
-}
 
-void Search::populateHomeData(const QString& startDateTime, const QString& endDateTime)
-{
-    std::optional<QVector<QVector<QString>>> homeList = Database::instance().getSearchListHome(startDateTime, endDateTime);
-    if (homeList) {
-        resultsTable->setRowCount(homeList->size());
-
-        for (int i = 0; i < homeList->size(); ++i) {
-            const QVector<QString>& row = homeList->at(i);
-
-            // 날짜시간 (감지시각) - 형식 변경
-            QString formattedDateTime = row.size() > 3 ? formatDateTime(row[3]) : "";
-            QTableWidgetItem *dateItem = new QTableWidgetItem(formattedDateTime);
-            resultsTable->setItem(i, 0, dateItem);
-
-            // 분류
-            QTableWidgetItem *categoryItem = new QTableWidgetItem("온도");
-            resultsTable->setItem(i, 1, categoryItem);
-
-            // 값 (온도)
-            QString value = row.size() > 0 ? (row[0] + "°C") : "";
-            QTableWidgetItem *valueItem = new QTableWidgetItem(value);
-            resultsTable->setItem(i, 2, valueItem);
-        }
+    // 집계 단위 - "자동"이면 기간 길이로 결정, 숫자 값이 없는 카테고리(펫)는 항상 원본
+    const int bucketChoice = aggregationComboBox->currentData().toInt();
+    SearchBucket bucket = bucketChoice < 0 ? Database::autoBucket(searchEnd - searchStart)
+                                           : static_cast<SearchBucket>(bucketChoice);
+    if (!Database::supportsAggregation(searchCategory))
+        bucket = SearchBucket::Raw;
+
+    if (bucket != SearchBucket::Raw) {
+        // 집계 결과는 한 번에 받으므로 페이지 요청 없음
+        searchHasMore = false;
+        resultsModel->reset(searchCategory, true);
+
+        const quint64 generation = searchGeneration;
+        Database::instance()
+            .getSearchAggregateAsync(searchCategory, SearchHomeId, searchStart, searchEnd, bucket)
+            .then(this, [this, generation](std::optional<SearchPage> page) {
+                if (generation != searchGeneration)
+                    return;
+                if (page)
+                    resultsModel->appendPage(*page);
+                else
+                    resultsModel->setHasMore(false);
+            });
+        return;
     }
+
+    // 이미 읽어 둔 구간은 캐시에서, 나머지 구간만 DB 에서 최신순으로 이어서 읽는다
+    searchSpans = searchCache.plan(searchCategory, SearchHomeId, searchStart, searchEnd);
+    searchCacheEpoch = searchCache.epoch(searchCategory, SearchHomeId);
+    searchSpanIndex = 0;
+    searchTieRows = SearchColumns();
+    searchHasMore = !searchSpans.isEmpty();
+
+    // 모델을 비우는 중에 뷰가 fetchMore 를 부를 수 있으므로 검색 상태를 먼저 갱신한 뒤 초기화
+    resultsModel->reset(searchCategory);
+    requestNextPage();
 }
 
-void Search::populateFireData(const QString& startDateTime, const QString& endDateTime)
+void Search::advanceSpan()
 {
-    std::optional<QVector<QVector<QString>>> fireList = Database::instance().getSearchListFire(startDateTime, endDateTime);
-    if (fireList) {
-        resultsTable->setRowCount(fireList->size());
-
-        for (int i = 0; i < fireList->size(); ++i) {
-            const QVector<QString>& row = fireList->at(i);
-
-            // 날짜시간 - 형식 변경
-            QString formattedDateTime = row.size() > 2 ? formatDateTime(row[2]) : "";
-            QTableWidgetItem *dateItem = new QTableWidgetItem(formattedDateTime);
-            resultsTable->setItem(i, 0, dateItem);
-
-            // 분류
-            QTableWidgetItem *categoryItem = new QTableWidgetItem("화재");
-            resultsTable->setItem(i, 1, categoryItem);
-
-            // 값 (화재상태 + 화재수치)
-            QString value = "";
-            if (row.size() > 1) {
-                value = row[0] + " (" + row[1] + ")";
-            }
-            QTableWidgetItem *valueItem = new QTableWidgetItem(value);
-            resultsTable->setItem(i, 2, valueItem);
-        }
-    }
+    ++searchSpanIndex;
+    searchCursor = SearchCursor();
+    searchTieRows = SearchColumns();
+    searchHasMore = searchSpanIndex < searchSpans.size();
 }
 
-void Search::populateGasData(const QString& startDateTime, const QString& endDateTime)
+void Search::invalidateCache(SearchCategory category, qint64 sinceId)
 {
-    std::optional<QVector<QVector<QString>>> gasList = Database::instance().getSearchListGas(startDateTime, endDateTime);
-    if (gasList) {
-        resultsTable->setRowCount(gasList->size());
-
-        for (int i = 0; i < gasList->size(); ++i) {
-            const QVector<QString>& row = gasList->at(i);
-
-            // 날짜시간 - 형식 변경
-            QString formattedDateTime = row.size() > 2 ? formatDateTime(row[2]) : "";
-            QTableWidgetItem *dateItem = new QTableWidgetItem(formattedDateTime);
-            resultsTable->setItem(i, 0, dateItem);
-
-            // 분류
-            QTableWidgetItem *categoryItem = new QTableWidgetItem("가스");
-            resultsTable->setItem(i, 1, categoryItem);
-
-            // 값 (가스누출상태 + 가스수치)
-            QString value = "";
-            if (row.size() > 1) {
-                value = row[0] + " (" + row[1] + ")";
-            }
-            QTableWidgetItem *valueItem = new QTableWidgetItem(value);
-            resultsTable->setItem(i, 2, valueItem);
-        }
-    }
+    // 새 행 중 가장 오래된 시각 이후만 잘라내고, 그 전의 닫힌 구간은 캐시에 남긴다
+    // 조회에 실패하면 그 카테고리 캐시 전체를 잘라낸다
+    // 진행 중인 검색의 남은 캐시 조각은 requestNextPage 가 epoch 를 보고 DB 조회로 바꾼다
+    Database::instance()
+        .getOldestTimeAfterIdAsync(category, SearchHomeId, sinceId)
+        .then(this, [this, category](std::optional<qint64> oldestMs) {
+            searchCache.invalidate(category, SearchHomeId, oldestMs.value_or(std::numeric_limits<qint64>::min()));
+        });
 }
 
-void Search::populatePlantData(const QString& startDateTime, const QString& endDateTime)
+void Search::requestNextPage()
 {
-    std::optional<QVector<QVector<QString>>> plantList = Database::instance().getSearchListPlant(startDateTime, endDateTime);
-    if (plantList) {
-        resultsTable->setRowCount(plantList->size());
-
-        for (int i = 0; i < plantList->size(); ++i) {
-            const QVector<QString>& row = plantList->at(i);
-
-            // 날짜시간 - 형식 변경
-            QString formattedDateTime = row.size() > 1 ? formatDateTime(row[1]) : "";
-            QTableWidgetItem *dateItem = new QTableWidgetItem(formattedDateTime);
-            resultsTable->setItem(i, 0, dateItem);
-
-            // 분류
-            QTableWidgetItem *categoryItem = new QTableWidgetItem("식물");
-            resultsTable->setItem(i, 1, categoryItem);
-
-            // 값 (토양습도)
-            QString value = row.size() > 0 ? (row[0] + "%") : "";
-            QTableWidgetItem *valueItem = new QTableWidgetItem(value);
-            resultsTable->setItem(i, 2, valueItem);
-        }
+    // 계획 이후 캐시가 비워지거나 잘렸으면 (용량 초과, 새 행 도착) 남은 캐시 조각은 DB 에서 다시 읽는다
+    const quint64 cacheEpoch = searchCache.epoch(searchCategory, SearchHomeId);
+    if (searchCacheEpoch != cacheEpoch) {
+        for (int i = searchSpanIndex; i < searchSpans.size(); ++i)
+            searchSpans[i].cached = false;
+        searchCacheEpoch = cacheEpoch;
     }
-}
 
-void Search::populatePetData(const QString& startDateTime, const QString& endDateTime)
-{
-    std::optional<QVector<QVector<QString>>> petList = Database::instance().getSearchListPet(startDateTime, endDateTime);
-    if (petList) {
-        resultsTable->setRowCount(petList->size() * 3); // 급식, 급수, 배변으로 3개 행
-
-        int tableRow = 0;
-        for (int i = 0; i < petList->size(); ++i) {
-            const QVector<QString>& row = petList->at(i);
-            QString formattedDateTime = row.size() > 3 ? formatDateTime(row[3]) : "";
-
-            // 급식 행
-            resultsTable->setItem(tableRow, 0, new QTableWidgetItem(formattedDateTime));
-            resultsTable->setItem(tableRow, 1, new QTableWidgetItem("펫(급식)"));
-            resultsTable->setItem(tableRow, 2, new QTableWidgetItem(row.size() > 0 ? row[0] : ""));
-            tableRow++;
-
-            // 급수 행
-            resultsTable->setItem(tableRow, 0, new QTableWidgetItem(formattedDateTime));
-            resultsTable->setItem(tableRow, 1, new QTableWidgetItem("펫(급수)"));
-            resultsTable->setItem(tableRow, 2, new QTableWidgetItem(row.size() > 1 ? row[1] : ""));
-            tableRow++;
-
-            // 배변 행
-            resultsTable->setItem(tableRow, 0, new QTableWidgetItem(formattedDateTime));
-            resultsTable->setItem(tableRow, 1, new QTableWidgetItem("펫(배변)"));
-            resultsTable->setItem(tableRow, 2, new QTableWidgetItem(row.size() > 2 ? row[2] : ""));
-            tableRow++;
-        }
+    while (searchHasMore && !pageRequestInFlight) {
+        const SearchCache::Span span = searchSpans.at(searchSpanIndex);
+        if (!span.cached)
+            break;
+
+        // 캐시된 조각은 DB 왕복 없이 바로 표시 (비어 있으면 다음 조각으로)
+        SearchPage page;
+        page.category = searchCategory;
+        page.columns = searchCache.slice(searchCategory, SearchHomeId, span.first, span.last);
+        advanceSpan();
+        page.hasMore = searchHasMore;
+        resultsModel->appendPage(page);
+        if (std::visit([](const auto& columns) { return columns.size(); }, page.columns) > 0)
+            return;
+    }
+
+    if (!searchHasMore || pageRequestInFlight) {
+        resultsModel->setHasMore(searchHasMore);
+        return;
+    }
+
+    const SearchCache::Span span = searchSpans.at(searchSpanIndex);
+    if (!searchCursor.isValid()) {
+        // 현재 시각 이후는 아직 행이 더 들어올 수 있으므로 조회 시점까지만 캐시된 것으로 기록
+        searchSpanTop = qMin(span.last, QDateTime::currentMSecsSinceEpoch());
     }
+
+    pageRequestInFlight = true;
+    const quint64 generation = searchGeneration;
+    Database::instance()
+        .getSearchPageAsync(searchCategory, SearchHomeId, span.first, span.last, searchCursor, SearchPageSize)
+        .then(this, [this, generation, span, cacheEpoch](std::optional<SearchPage> page) {
+            if (generation != searchGeneration)
+                return;
+            pageRequestInFlight = false;
+            if (!page) {
+                searchHasMore = false;
+                resultsModel->setHasMore(false);
+                return;
+            }
+
+            // 마지막 행과 같은 시각의 행이 다음 페이지에 더 있을 수 있으므로 그 시각은 제외하고 기록
+            // 페이지마다 자기 구간만 기록해야 중간에 캐시가 비워져도 빠진 행을 덮는 구간이 남지 않는다
+            // 조회 중에 캐시가 잘렸다면 이 페이지는 새 행 이전에 읽었을 수 있으므로 기록하지 않는다
+            const qint64 bottom = page->hasMore ? page->next.timeMs + 1 : span.first;
+            if (searchCache.epoch(searchCategory, SearchHomeId) == cacheEpoch)
+                searchCache.insert(searchCategory, SearchHomeId, concatColumns(searchTieRows, page->columns),
+                                   { bottom, searchSpanTop });
+            searchSpanTop = bottom - 1;
+            searchTieRows = page->hasMore ? rowsAtBottom(page->columns) : SearchColumns();
+
+            searchCursor = page->next;
+            if (!page->hasMore)
+                advanceSpan();
+            page->hasMore = searchHasMore;
+            resultsModel->appendPage(*page);
+
+            // 빈 조각이었다면 뷰가 다시 fetchMore 를 부르지 않으므로 이어서 요청
+            if (std::visit([](const auto& columns) { return columns.size(); }, page->columns) == 0)
+                requestNextPage();
+        });
 }
 
-void Search::clearTable()
+void Search::onExportClicked()
 {
-    resultsTable->setRowCount(0);
+    const QString path = QFileDialog::getSaveFileName(this, "검색 결과 내보내기",
+                                                      "search.hstx", "센서 기록 (*.hstx)");
+    if (path.isEmpty())
+        return;
+
+    // 화면에 보이는 범위와 같도록 입력 값이 아니라 마지막 검색 조건을 사용
+    ++exportGeneration;
+    exportPath = path;
+    exportCategory = searchCategory;
+    exportStart = searchStart;
+    exportEnd = searchEnd;
+    exportCursor = SearchCursor();
+    exportColumns.reset();
+
+    if (!Database::instance().isConnected()) {
+        finishExport(localSearchPage(exportCategory, exportStart, exportEnd).columns);
+        return;
+    }
+
+    exportButton->setEnabled(false);
+    requestExportPage();
 }
 
-QString Search::formatDateTime(const QString& dateTimeStr)
+void Search::requestExportPage()
 {
-    // "2025-09-10T11:27:57.000Z" -> "2025-09-10 11:27"
-    QDateTime dt = QDateTime::fromString(dateTimeStr, Qt::ISODate);
-    if (dt.isValid()) {
-        return dt.toString("yyyy-MM-dd hh:mm");
-    }
+    const quint64 generation = exportGeneration;
+    Database::instance()
+        .getSearchPageAsync(exportCategory, SearchHomeId, exportStart, exportEnd, exportCursor, ExportPageSize)
+        .then(this, [this, generation](std::optional<SearchPage> page) {
+            if (generation != exportGeneration)
+                return;
+            if (!page) {
+                exportButton->setEnabled(true);
+                QMessageBox::warning(this, "내보내기", "검색 결과를 읽지 못했습니다.");
+                return;
+            }
 
-    // ISO 형식이 아닌 경우 다른 형식 시도
-    dt = QDateTime::fromString(dateTimeStr, "yyyy-MM-ddThh:mm:ss.zzzZ");
-    if (dt.isValid()) {
-        return dt.toString("yyyy-MM-dd hh:mm");
-    }
+            // 페이지 컬럼을 같은 타입의 누적 컬럼 뒤에 이어 붙임
+            if (!exportColumns) {
+                exportColumns = std::move(page->columns);
+            } else {
+                std::visit([&page](auto& columns) {
+                    using Columns = std::decay_t<decltype(columns)>;
+                    columns.append(std::get<Columns>(page->columns));
+                }, *exportColumns);
+            }
 
-    // MySQL DATETIME 형식 시도 (YYYY-MM-DD HH:MM:SS)
-    dt = QDateTime::fromString(dateTimeStr, "yyyy-MM-dd hh:mm:ss");
-    if (dt.isValid()) {
-        return dt.toString("yyyy-MM-dd hh:mm");
-    }
+            if (page->hasMore) {
+                exportCursor = page->next;
+                requestExportPage();
+                return;
+            }
 
-    // 초단위까지 포함된 형식 시도
-    dt = QDateTime::fromString(dateTimeStr, "yyyy-MM-dd hh:mm:ss.zzz");
-    if (dt.isValid()) {
-        return dt.toString("yyyy-MM-dd hh:mm");
+            exportButton->setEnabled(true);
+            finishExport(*exportColumns);
+            exportColumns.reset();
+        });
+}
+
+void Search::finishExport(const SearchColumns& columns)
+{
+    QString errorText;
+    if (!SearchExport::write(exportPath, exportCategory, columns, &errorText)) {
+        qWarning() << "검색 결과 내보내기 실패:" << exportPath << errorText;
+        QMessageBox::warning(this, "내보내기", "파일을 저장하지 못했습니다.\n" + errorText);
+        return;
     }
 
-    // 변환 실패 시 원본 반환
-    return dateTimeStr;
+    const int rows = std::visit([](const auto& c) { return c.size(); }, columns);
+    qDebug() << "검색 결과 내보내기 완료:" << exportPath << rows << "행";
 }
 
 QPushButton* Search::createCircleButton(const QString& iconPath)
@@ -649,7 +824,7 @@ void Search::setupStyles()
                          "}"
 
                          // 테이블 스타일
-                         "QTableWidget#resultsTable {"
+                         "QTableView#resultsTable {"
                          "    background-color: white;"
                          "    border: 2px solid %3;"
                          "    border-radius: 15px;"
@@ -660,17 +835,17 @@ void Search::setupStyles()
                          "    margin: 0px;"
                          "}"
 
-                         "QTableWidget#resultsTable::item {"
+                         "QTableView#resultsTable::item {"
                          "    padding: 10px;"
                          "    border-bottom: 1px solid %3;"
                          "}"
 
-                         "QTableWidget#resultsTable::item:selected {"
+                         "QTableView#resultsTable::item:selected {"
                          "    background-color: %6;"
                          "    color: %2;"
                          "}"
 
-                         "QTableWidget#resultsTable::item:alternate {"
+                         "QTableView#resultsTable::item:alternate {"
                          "    background-color: #FAFAFA;"
                          "}"
 
@@ -16,12 +16,13 @@
 #include <QGraphicsDropShadowEffect>
 #include <QComboBox>
 #include <QDateTimeEdit>  // QDateEdit에서 QDateTimeEdit으로 변경
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QHeaderView>
 #include <QDate>
 #include <QDateTime>      // QDateTime 헤더 추가
 #include "database.h"
+#include "searchtablemodel.h"
+#include "searchcache.h"
 
 class Search : public QWidget
 {
@@ -31,6 +32,12 @@ public:
     explicit Search(QWidget *parent = nullptr);
     ~Search();
 
+    // 테이블에 새 행이 들어왔을 때 (ChangeFeed) id > sinceId 인 새 행 중 가장 오래된 시각 이후의 검색 캐시만 잘라낸다
+    void invalidateCache(SearchCategory category, qint64 sinceId);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
 signals:
     void backToMain();  // 메인 화면으로 돌아가는 시그널
     void goToCertified();
@@ -42,6 +49,8 @@ private slots:
     void onSafetyClicked();
     void onSearchClicked();  // 조회 버튼 클릭
     void onCategoryChanged(const QString& category);  // 카테고리 변경
+    void requestNextPage();  // 모델이 다음 페이지를 요청할 때
+    void onExportClicked();  // 내보내기 버튼 클릭
 
 private:
     void setupUI();
@@ -50,7 +59,6 @@ private:
     void applyShadowEffect(QWidget* widget);
     QPushButton* createCircleButton(const QString& icon);
     QPixmap loadResourceImage(const QString& imagePath, const QSize& size = QSize());
-    QString formatDateTime(const QString& dateTimeStr);
 
     // Layout creation methods
     void createHeader(QVBoxLayout *canvasLayout);
@@ -62,12 +70,9 @@ private:
 
     // Data loading methods
     void loadSearchData();
-    void populateHomeData(const QString& startDateTime, const QString& endDateTime);
-    void populateFireData(const QString& startDateTime, const QString& endDateTime);
-    void populateGasData(const QString& startDateTime, const QString& endDateTime);
-    void populatePlantData(const QString& startDateTime, const QString& endDateTime);
-    void populatePetData(const QString& startDateTime, const QString& endDateTime);
-    void clearTable();
+    void advanceSpan();  // 다음 캐시/DB 조각으로 이동
+    void requestExportPage();  // 내보낼 범위를 DB 에서 이어서 읽기
+    void finishExport(const SearchColumns& columns);
 
     // UI Components
     QWidget *headerWidget;
@@ -76,18 +81,47 @@ private:
     QWidget *contentArea;
 
     QComboBox *categoryComboBox;
+    QComboBox *aggregationComboBox;  // 집계 단위 (자동/원본/분/시간/일)
     QDateTimeEdit *startDateTimeEdit;  // 변경된 멤버 변수명
     QDateTimeEdit *endDateTimeEdit;    // 변경된 멤버 변수명
     QPushButton *searchButton;
+    QPushButton *exportButton;
 
     // Search results table
-    QTableWidget *resultsTable;
+    QTableView *resultsTable;
+    SearchTableModel *resultsModel;
 
     // Control buttons
     QPushButton *cameraButton;
     QPushButton *homeButton;
     QPushButton *searchNavButton;
     QPushButton *lockButton;
+
+    quint64 searchGeneration;  // 마지막으로 요청한 검색 번호
+    bool initialSearchDone;  // 첫 표시 때 한 번만 기본 조회
+
+    // 진행 중인 검색의 키셋 페이지 상태
+    SearchCategory searchCategory;
+    qint64 searchStart;  // epoch ms
+    qint64 searchEnd;
+    SearchCursor searchCursor;
+    QVector<SearchCache::Span> searchSpans;  // 요청 범위를 캐시/DB 조각으로 나눈 것 (최신순)
+    int searchSpanIndex;
+    qint64 searchSpanTop;  // 현재 DB 조각에서 다음 페이지가 캐시에 기록할 구간의 윗단
+    SearchColumns searchTieRows;  // 직전 페이지 경계 시각의 행 (다음 페이지와 함께 캐시에 기록)
+    SearchCache searchCache;
+    quint64 searchCacheEpoch;  // searchSpans 를 계획한 시점의 현재 카테고리 캐시 epoch
+    bool searchHasMore;
+    bool pageRequestInFlight;
+
+    // 진행 중인 내보내기 (마지막 검색의 카테고리/범위 전체를 원본으로)
+    quint64 exportGeneration;
+    QString exportPath;
+    SearchCategory exportCategory;
+    qint64 exportStart;
+    qint64 exportEnd;
+    SearchCursor exportCursor;
+    std::optional<SearchColumns> exportColumns;
 };
 
 #endif // SEARCH_H
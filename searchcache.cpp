@@ -0,0 +1,218 @@
+#include "searchcache.h"
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+QString SearchCache::key(SearchCategory category, const QString& homeId)
+{
+    return homeId + QLatin1Char(':') + QString::number(static_cast<int>(category));
+}
+
+bool SearchCache::isCovered(const QVector<Interval>& covered, qint64 ts)
+{
+    for (const Interval& interval : covered) {
+        if (interval.first > ts)
+            return false;
+        if (ts <= interval.last)
+            return true;
+    }
+    return false;
+}
+
+void SearchCache::addInterval(QVector<Interval>& covered, Interval interval)
+{
+    // 겹치거나 맞닿은 구간은 하나로 합친다
+    QVector<Interval> merged;
+    merged.reserve(covered.size() + 1);
+    bool placed = false;
+    for (const Interval& current : covered) {
+        if (current.last + 1 < interval.first) {
+            merged.append(current);
+        } else if (interval.last + 1 < current.first) {
+            if (!placed) {
+                merged.append(interval);
+                placed = true;
+            }
+            merged.append(current);
+        } else {
+            interval.first = qMin(interval.first, current.first);
+            interval.last = qMax(interval.last, current.last);
+        }
+    }
+    if (!placed)
+        merged.append(interval);
+    covered.swap(merged);
+}
+
+QVector<SearchCache::Span> SearchCache::plan(SearchCategory category, const QString& homeId,
+                                             qint64 first, qint64 last) const
+{
+    QVector<Span> spans;
+    if (first > last)
+        return spans;
+
+    auto it = m_entries.constFind(key(category, homeId));
+    if (it == m_entries.constEnd()) {
+        spans.append({ first, last, false });
+        return spans;
+    }
+
+    // 최신 구간부터 내려가며 캐시된 부분과 빈 부분을 번갈아 기록
+    qint64 top = last;
+    const QVector<Interval>& covered = it.value().covered;
+    for (int i = covered.size() - 1; i >= 0 && top >= first; --i) {
+        const Interval& interval = covered.at(i);
+        if (interval.first > top)
+            continue;
+        if (interval.last < first)
+            break;
+
+        const qint64 cachedFirst = qMax(interval.first, first);
+        const qint64 cachedLast = qMin(interval.last, top);
+        if (cachedLast < top)
+            spans.append({ cachedLast + 1, top, false });
+        spans.append({ cachedFirst, cachedLast, true });
+        top = cachedFirst - 1;
+    }
+    if (top >= first)
+        spans.append({ first, top, false });
+    return spans;
+}
+
+SearchColumns SearchCache::slice(SearchCategory category, const QString& homeId,
+                                 qint64 first, qint64 last) const
+{
+    auto it = m_entries.constFind(key(category, homeId));
+    if (it == m_entries.constEnd() || it.value().chunks.isEmpty())
+        return SearchColumns();
+
+    SearchColumns result = it.value().chunks.first().columns;
+    std::visit([&](auto& out) {
+        using Columns = std::decay_t<decltype(out)>;
+        out = Columns();
+
+        for (const Chunk& chunk : it.value().chunks) {
+            if (chunk.newest < first)
+                break;  // 이후 묶음은 모두 더 오래된 행
+            const Columns& columns = std::get<Columns>(chunk.columns);
+
+            // 내림차순 배열에서 ts <= last 인 첫 행 ~ ts < first 인 첫 행 직전까지
+            auto begin = std::lower_bound(columns.ts.cbegin(), columns.ts.cend(), last, std::greater<qint64>());
+            auto end = std::upper_bound(begin, columns.ts.cend(), first, std::greater<qint64>());
+            for (int i = int(begin - columns.ts.cbegin()); i < int(end - columns.ts.cbegin()); ++i)
+                out.appendRow(columns, i);
+        }
+    }, result);
+    return result;
+}
+
+void SearchCache::insert(SearchCategory category, const QString& homeId,
+                         const SearchColumns& columns, Interval covered)
+{
+    if (covered.first > covered.last)
+        return;
+
+    auto it = m_entries.find(key(category, homeId));
+    if (it == m_entries.end()) {
+        it = m_entries.insert(key(category, homeId), Entry());
+        it.value().epoch = ++m_nextEpoch;
+    }
+    Entry& entry = it.value();
+
+    // 구간 안에 있고 아직 캐시에 없는 행만 새 묶음으로
+    Chunk chunk;
+    chunk.newest = covered.first;
+    chunk.columns = columns;
+    const int added = std::visit([&](auto& out) {
+        using Columns = std::decay_t<decltype(out)>;
+        const Columns& incoming = std::get<Columns>(columns);
+        out = Columns();
+        out.reserve(incoming.size());
+        for (int i = 0; i < incoming.size(); ++i) {
+            const qint64 ts = incoming.ts[i];
+            if (ts < covered.first || ts > covered.last || isCovered(entry.covered, ts))
+                continue;
+            out.appendRow(incoming, i);
+        }
+        if (out.size() > 0)
+            chunk.newest = out.ts.first();
+        return out.size();
+    }, chunk.columns);
+
+    // 용량 초과 또는 다른 종류의 행이 섞이면 이 카테고리 캐시를 비우고 다시 시작
+    const bool mismatched = !entry.chunks.isEmpty()
+                            && entry.chunks.first().columns.index() != chunk.columns.index();
+    if (mismatched || entry.rows + added > MaxRowsPerEntry) {
+        entry = Entry();
+        entry.epoch = ++m_nextEpoch;
+    }
+
+    addInterval(entry.covered, covered);
+    if (added == 0)
+        return;
+
+    auto pos = std::lower_bound(entry.chunks.begin(), entry.chunks.end(), chunk.newest,
+                                [](const Chunk& c, qint64 newest) { return c.newest > newest; });
+    entry.chunks.insert(pos, chunk);
+    entry.rows += added;
+}
+
+void SearchCache::invalidate(SearchCategory category, const QString& homeId, qint64 fromMs)
+{
+    auto it = m_entries.find(key(category, homeId));
+    if (it == m_entries.end())
+        return;
+    Entry& entry = it.value();
+
+    // 캐시된 행은 모두 covered 안에 있으므로, 마지막 구간이 fromMs 전에 끝나면 잘라낼 것이 없다 (epoch 유지)
+    if (entry.covered.isEmpty() || entry.covered.last().last < fromMs)
+        return;
+
+    // fromMs 이후를 덮는 구간은 fromMs 직전까지로 줄인다
+    QVector<Interval> covered;
+    for (const Interval& interval : entry.covered) {
+        if (interval.first >= fromMs)
+            break;
+        covered.append({ interval.first, qMin(interval.last, fromMs - 1) });
+    }
+    entry.covered.swap(covered);
+
+    // 묶음은 시각 내림차순이므로 앞쪽의 ts >= fromMs 행만 뺀다
+    entry.rows = 0;
+    for (auto chunk = entry.chunks.begin(); chunk != entry.chunks.end();) {
+        const int remaining = std::visit([&](auto& columns) {
+            using Columns = std::decay_t<decltype(columns)>;
+            auto kept = std::upper_bound(columns.ts.cbegin(), columns.ts.cend(), fromMs, std::greater<qint64>());
+            const int drop = int(kept - columns.ts.cbegin());
+            if (drop > 0) {
+                Columns rest;
+                rest.reserve(columns.size() - drop);
+                for (int i = drop; i < columns.size(); ++i)
+                    rest.appendRow(columns, i);
+                columns = rest;
+            }
+            if (columns.size() > 0)
+                chunk->newest = columns.ts.first();
+            return columns.size();
+        }, chunk->columns);
+
+        if (remaining == 0) {
+            chunk = entry.chunks.erase(chunk);
+        } else {
+            entry.rows += remaining;
+            ++chunk;
+        }
+    }
+    entry.epoch = ++m_nextEpoch;
+}
+
+void SearchCache::clear()
+{
+    m_entries.clear();
+}
+
+quint64 SearchCache::epoch(SearchCategory category, const QString& homeId) const
+{
+    auto it = m_entries.constFind(key(category, homeId));
+    return it == m_entries.constEnd() ? 0 : it.value().epoch;
+}
@@ -0,0 +1,77 @@
+#ifndef SEARCHCACHE_H
+#define SEARCHCACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "database.h"
+
+// 검색 원본 행 캐시 (집/카테고리별)
+// - 이미 읽어 온 시각 구간 [first, last] 목록과 그 구간의 행을 최신순으로 보관
+// - plan() 으로 요청 범위를 "캐시에서 꺼낼 구간"과 "DB 에서 읽을 구간"으로 나눠, 없는 부분만 조회
+// - 현재 시각 이후로 열린 범위는 조회 시점까지만 채워진 것으로 기록해야 새 행을 놓치지 않는다
+// - 한 카테고리의 행이 MaxRowsPerEntry 를 넘으면 그 카테고리 캐시를 통째로 비운다
+// - 테이블에 새 행이 들어오면(ChangeFeed) invalidate() 로 새 행 중 가장 오래된 시각 이후만 잘라낸다
+//   그보다 이전의 닫힌 구간은 그대로 캐시에 남는다 (늦게 들어온 과거 시각 행만 다시 읽음)
+// - epoch() 는 집/카테고리별. 그 항목을 비우거나 잘라낼 때만 바뀌며, plan() 결과의 cached 조각은 epoch 가 같을 때만 유효
+class SearchCache
+{
+public:
+    // 닫힌 시각 구간 (epoch ms)
+    struct Interval
+    {
+        qint64 first;
+        qint64 last;
+    };
+
+    // 요청 범위를 나눈 조각 (최신 구간부터)
+    struct Span
+    {
+        qint64 first;
+        qint64 last;
+        bool cached;    // true 면 slice() 로 꺼내고, false 면 DB 조회 필요
+    };
+
+    static constexpr int MaxRowsPerEntry = 1000000;
+
+    QVector<Span> plan(SearchCategory category, const QString& homeId, qint64 first, qint64 last) const;
+
+    // [first, last] 범위의 캐시된 행 (최신순)
+    SearchColumns slice(SearchCategory category, const QString& homeId, qint64 first, qint64 last) const;
+
+    // covered 구간을 읽었다고 기록하고, columns 중 그 구간에 속하면서 아직 캐시에 없는 행만 합친다
+    // covered 는 plan() 이 돌려준 캐시되지 않은 조각 안이어야 한다
+    void insert(SearchCategory category, const QString& homeId, const SearchColumns& columns, Interval covered);
+
+    // 집/카테고리 캐시에서 fromMs 이후 구간과 행을 잘라낸다 (fromMs 이전 구간은 유지)
+    void invalidate(SearchCategory category, const QString& homeId, qint64 fromMs);
+    void clear();
+
+    // 집/카테고리 항목의 epoch (항목이 없으면 0)
+    quint64 epoch(SearchCategory category, const QString& homeId) const;
+
+private:
+    // insert() 한 번에 들어온 행 묶음 - 묶음끼리는 시각 범위가 겹치지 않는다
+    struct Chunk
+    {
+        qint64 newest;                  // 묶음 안 최신 행 시각 (정렬 키)
+        SearchColumns columns;          // 시각 내림차순
+    };
+
+    struct Entry
+    {
+        QVector<Chunk> chunks;          // newest 내림차순
+        QVector<Interval> covered;      // first 오름차순, 서로 겹치지 않음
+        int rows = 0;
+        quint64 epoch = 0;              // 만들거나 비우거나 잘라낼 때마다 m_nextEpoch 에서 새로 받음
+    };
+
+    static QString key(SearchCategory category, const QString& homeId);
+    static bool isCovered(const QVector<Interval>& covered, qint64 ts);
+    static void addInterval(QVector<Interval>& covered, Interval interval);
+
+    QHash<QString, Entry> m_entries;
+    quint64 m_nextEpoch = 0;          // 항목마다 다른 epoch 를 주기 위한 카운터 (삭제 후 다시 만든 항목과도 구분)
+};
+
+#endif // SEARCHCACHE_H
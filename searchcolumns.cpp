@@ -0,0 +1,144 @@
+#include "searchcolumns.h"
+
+namespace {
+
+// other 사전의 코드를 target 사전의 코드로 바꿔 이어 붙임 (페이지마다 사전이 따로 만들어지므로)
+void appendCodes(QVector<quint16>& codes, StringDictionary& target,
+                 const QVector<quint16>& otherCodes, const StringDictionary& other)
+{
+    QVector<quint16> remap(other.size());
+    for (int i = 0; i < other.size(); ++i)
+        remap[i] = target.intern(other.value(static_cast<quint16>(i)));
+
+    codes.reserve(codes.size() + otherCodes.size());
+    for (quint16 code : otherCodes)
+        codes.append(remap[code]);
+}
+
+} // namespace
+
+quint16 StringDictionary::intern(const QString& value)
+{
+    auto it = m_codes.constFind(value);
+    if (it != m_codes.constEnd())
+        return it.value();
+
+    const quint16 code = static_cast<quint16>(m_values.size());
+    m_values.append(value);
+    m_codes.insert(value, code);
+    return code;
+}
+
+void HomeEnvColumns::reserve(int n)
+{
+    ts.reserve(n);
+    temperature.reserve(n);
+    humidity.reserve(n);
+    illumination.reserve(n);
+}
+
+void HomeEnvColumns::append(const HomeEnvColumns& other)
+{
+    ts += other.ts;
+    temperature += other.temperature;
+    humidity += other.humidity;
+    illumination += other.illumination;
+}
+
+void HomeEnvColumns::appendRow(const HomeEnvColumns& other, int i)
+{
+    ts.append(other.ts[i]);
+    temperature.append(other.temperature[i]);
+    humidity.append(other.humidity[i]);
+    illumination.append(other.illumination[i]);
+}
+
+void EventColumns::reserve(int n)
+{
+    ts.reserve(n);
+    status.reserve(n);
+    level.reserve(n);
+}
+
+void EventColumns::append(const EventColumns& other)
+{
+    ts += other.ts;
+    appendCodes(status, statusNames, other.status, other.statusNames);
+    level += other.level;
+}
+
+void EventColumns::appendRow(const EventColumns& other, int i)
+{
+    ts.append(other.ts[i]);
+    status.append(statusNames.intern(other.statusNames.value(other.status[i])));
+    level.append(other.level[i]);
+}
+
+void PlantColumns::reserve(int n)
+{
+    ts.reserve(n);
+    soilMoisture.reserve(n);
+}
+
+void PlantColumns::append(const PlantColumns& other)
+{
+    ts += other.ts;
+    soilMoisture += other.soilMoisture;
+}
+
+void PlantColumns::appendRow(const PlantColumns& other, int i)
+{
+    ts.append(other.ts[i]);
+    soilMoisture.append(other.soilMoisture[i]);
+}
+
+void PetColumns::reserve(int n)
+{
+    ts.reserve(n);
+    food.reserve(n);
+    water.reserve(n);
+    toilet.reserve(n);
+}
+
+void PetColumns::append(const PetColumns& other)
+{
+    ts += other.ts;
+    appendCodes(food, names, other.food, other.names);
+    appendCodes(water, names, other.water, other.names);
+    appendCodes(toilet, names, other.toilet, other.names);
+}
+
+void PetColumns::appendRow(const PetColumns& other, int i)
+{
+    ts.append(other.ts[i]);
+    food.append(names.intern(other.names.value(other.food[i])));
+    water.append(names.intern(other.names.value(other.water[i])));
+    toilet.append(names.intern(other.names.value(other.toilet[i])));
+}
+
+void AggregateColumns::reserve(int n)
+{
+    ts.reserve(n);
+    min.reserve(n);
+    avg.reserve(n);
+    max.reserve(n);
+    count.reserve(n);
+}
+
+void AggregateColumns::append(const AggregateColumns& other)
+{
+    ts += other.ts;
+    min += other.min;
+    avg += other.avg;
+    max += other.max;
+    count += other.count;
+}
+
+void AggregateColumns::appendRow(const AggregateColumns& other, int i)
+{
+    ts.append(other.ts[i]);
+    min.append(other.min[i]);
+    avg.append(other.avg[i]);
+    max.append(other.max[i]);
+    count.append(other.count[i]);
+}
@@ -0,0 +1,101 @@
+#ifndef SEARCHCOLUMNS_H
+#define SEARCHCOLUMNS_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <variant>
+
+// 검색 결과를 카테고리별 컬럼 배열(struct-of-arrays)로 보관
+// - 숫자는 숫자 그대로, 시각은 epoch ms 로 저장해 셀마다 QString 을 만들거나 다시 파싱하지 않는다
+// - 상태 문자열처럼 종류가 몇 개 안 되는 값은 사전 코드(quint16)로만 저장한다
+// - 같은 인덱스 i 가 한 행이며, 집계/차트는 각 배열을 그대로 순회하면 된다
+
+// 문자열 사전 - 같은 문자열은 한 번만 저장
+class StringDictionary
+{
+public:
+    quint16 intern(const QString& value);
+    const QString& value(quint16 code) const { return m_values.at(code); }
+    int size() const { return m_values.size(); }
+
+private:
+    QVector<QString> m_values;
+    QHash<QString, quint16> m_codes;
+};
+
+// 온도 (home_env)
+struct HomeEnvColumns
+{
+    QVector<qint64> ts;             // 측정 시각 (epoch ms)
+    QVector<float> temperature;
+    QVector<float> humidity;
+    QVector<int> illumination;
+
+    int size() const { return ts.size(); }
+    void reserve(int n);
+    void append(const HomeEnvColumns& other);  // 다음 페이지 이어 붙이기
+    void appendRow(const HomeEnvColumns& other, int i);  // other 의 i 번째 행 하나만 추가
+};
+
+// 화재/가스 (fire_events) - 상태 + 수치
+struct EventColumns
+{
+    QVector<qint64> ts;             // 감지 시각 (epoch ms)
+    QVector<quint16> status;        // statusNames 코드
+    QVector<float> level;
+    StringDictionary statusNames;
+
+    int size() const { return ts.size(); }
+    void reserve(int n);
+    void append(const EventColumns& other);
+    void appendRow(const EventColumns& other, int i);
+};
+
+// 식물 (plant_env)
+struct PlantColumns
+{
+    QVector<qint64> ts;
+    QVector<int> soilMoisture;
+
+    int size() const { return ts.size(); }
+    void reserve(int n);
+    void append(const PlantColumns& other);
+    void appendRow(const PlantColumns& other, int i);
+};
+
+// 펫 (pet_status) - 급식/급수/배변 상태는 하나의 사전을 공유
+struct PetColumns
+{
+    QVector<qint64> ts;
+    QVector<quint16> food;
+    QVector<quint16> water;
+    QVector<quint16> toilet;
+    StringDictionary names;
+
+    int size() const { return ts.size(); }
+    void reserve(int n);
+    void append(const PetColumns& other);
+    void appendRow(const PetColumns& other, int i);
+};
+
+// 구간 집계 결과 - 구간 시작 시각별 min/avg/max 와 표본 수
+struct AggregateColumns
+{
+    qint64 bucketMs = 0;            // 구간 크기
+    QVector<qint64> ts;             // 구간 시작 시각 (epoch ms)
+    QVector<float> min;
+    QVector<float> avg;
+    QVector<float> max;
+    QVector<int> count;
+
+    int size() const { return ts.size(); }
+    void reserve(int n);
+    void append(const AggregateColumns& other);
+    void appendRow(const AggregateColumns& other, int i);
+};
+
+// 화재와 가스는 같은 모양이라 EventColumns 를 함께 쓴다
+using SearchColumns = std::variant<HomeEnvColumns, EventColumns, PlantColumns, PetColumns, AggregateColumns>;
+
+#endif // SEARCHCOLUMNS_H
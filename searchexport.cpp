@@ -0,0 +1,275 @@
+#include "searchexport.h"
+#include "tscodec.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+
+namespace {
+
+const quint32 kMagic = 0x48535458;  // "HSTX"
+const quint16 kVersion = 1;
+
+// 파일 안의 값 컬럼 하나 - 숫자는 double 로, 사전 컬럼은 코드 값 + 사전 문자열
+struct ExportColumn
+{
+    QString name;
+    QVector<double> values;
+    QStringList dictionary;
+};
+
+template <typename T>
+QVector<double> toDoubles(const QVector<T>& values)
+{
+    QVector<double> result;
+    result.reserve(values.size());
+    for (const T& value : values)
+        result.append(static_cast<double>(value));
+    return result;
+}
+
+template <typename T>
+QVector<T> fromDoubles(const QVector<double>& values)
+{
+    QVector<T> result;
+    result.reserve(values.size());
+    for (double value : values)
+        result.append(static_cast<T>(value));
+    return result;
+}
+
+QStringList dictionaryValues(const StringDictionary& dictionary)
+{
+    QStringList values;
+    for (int i = 0; i < dictionary.size(); ++i)
+        values.append(dictionary.value(static_cast<quint16>(i)));
+    return values;
+}
+
+// 사전 문자열을 저장된 순서대로 intern 하면 코드가 파일과 같게 유지된다
+void restoreDictionary(StringDictionary& dictionary, const QStringList& values)
+{
+    for (const QString& value : values)
+        dictionary.intern(value);
+}
+
+QVector<ExportColumn> toExportColumns(const SearchColumns& columns)
+{
+    struct Visitor
+    {
+        QVector<ExportColumn> operator()(const HomeEnvColumns& c) const
+        {
+            return { { "temperature", toDoubles(c.temperature), {} },
+                     { "humidity", toDoubles(c.humidity), {} },
+                     { "illumination", toDoubles(c.illumination), {} } };
+        }
+        QVector<ExportColumn> operator()(const EventColumns& c) const
+        {
+            return { { "status", toDoubles(c.status), dictionaryValues(c.statusNames) },
+                     { "level", toDoubles(c.level), {} } };
+        }
+        QVector<ExportColumn> operator()(const PlantColumns& c) const
+        {
+            return { { "soil_moisture", toDoubles(c.soilMoisture), {} } };
+        }
+        QVector<ExportColumn> operator()(const PetColumns& c) const
+        {
+            const QStringList names = dictionaryValues(c.names);
+            return { { "food", toDoubles(c.food), names },
+                     { "water", toDoubles(c.water), names },
+                     { "toilet", toDoubles(c.toilet), names } };
+        }
+        QVector<ExportColumn> operator()(const AggregateColumns&) const
+        {
+            return {};
+        }
+    };
+    return std::visit(Visitor(), columns);
+}
+
+// 코드 값을 사전 문자열로 표시하는 컬럼
+bool isDictionaryColumn(const QString& name)
+{
+    return name == QLatin1String("status") || name == QLatin1String("food")
+           || name == QLatin1String("water") || name == QLatin1String("toilet");
+}
+
+const ExportColumn* findColumn(const QVector<ExportColumn>& columns, const char* name)
+{
+    for (const ExportColumn& column : columns) {
+        if (column.name == QLatin1String(name))
+            return &column;
+    }
+    return nullptr;
+}
+
+std::optional<SearchColumns> fromExportColumns(SearchCategory category, const QVector<qint64>& ts,
+                                               const QVector<ExportColumn>& columns)
+{
+    switch (category) {
+    case SearchCategory::HomeEnv: {
+        const ExportColumn* temperature = findColumn(columns, "temperature");
+        const ExportColumn* humidity = findColumn(columns, "humidity");
+        const ExportColumn* illumination = findColumn(columns, "illumination");
+        if (!temperature || !humidity || !illumination)
+            return std::nullopt;
+        HomeEnvColumns c;
+        c.ts = ts;
+        c.temperature = fromDoubles<float>(temperature->values);
+        c.humidity = fromDoubles<float>(humidity->values);
+        c.illumination = fromDoubles<int>(illumination->values);
+        return c;
+    }
+    case SearchCategory::Fire:
+    case SearchCategory::Gas: {
+        const ExportColumn* status = findColumn(columns, "status");
+        const ExportColumn* level = findColumn(columns, "level");
+        if (!status || !level)
+            return std::nullopt;
+        EventColumns c;
+        c.ts = ts;
+        restoreDictionary(c.statusNames, status->dictionary);
+        c.status = fromDoubles<quint16>(status->values);
+        c.level = fromDoubles<float>(level->values);
+        return c;
+    }
+    case SearchCategory::Plant: {
+        const ExportColumn* soil = findColumn(columns, "soil_moisture");
+        if (!soil)
+            return std::nullopt;
+        PlantColumns c;
+        c.ts = ts;
+        c.soilMoisture = fromDoubles<int>(soil->values);
+        return c;
+    }
+    case SearchCategory::Pet: {
+        const ExportColumn* food = findColumn(columns, "food");
+        const ExportColumn* water = findColumn(columns, "water");
+        const ExportColumn* toilet = findColumn(columns, "toilet");
+        if (!food || !water || !toilet)
+            return std::nullopt;
+        PetColumns c;
+        c.ts = ts;
+        restoreDictionary(c.names, toilet->dictionary);
+        c.food = fromDoubles<quint16>(food->values);
+        c.water = fromDoubles<quint16>(water->values);
+        c.toilet = fromDoubles<quint16>(toilet->values);
+        return c;
+    }
+    }
+    return std::nullopt;
+}
+
+void setError(QString* errorText, const QString& message)
+{
+    if (errorText)
+        *errorText = message;
+}
+
+} // namespace
+
+namespace SearchExport {
+
+bool write(const QString& path, SearchCategory category, const SearchColumns& columns, QString* errorText)
+{
+    if (std::holds_alternative<AggregateColumns>(columns)) {
+        setError(errorText, "집계 결과는 내보낼 수 없습니다");
+        return false;
+    }
+
+    const QVector<qint64>& ts = std::visit([](const auto& c) -> const QVector<qint64>& { return c.ts; }, columns);
+    const QVector<ExportColumn> values = toExportColumns(columns);
+
+    // 쓰는 도중 실패해도 이전 파일이 깨지지 않도록 임시 파일에 쓰고 교체
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        setError(errorText, file.errorString());
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kMagic << kVersion << quint8(category) << qint32(ts.size());
+    out << TsCodec::encodeTimestamps(ts.constData(), ts.size());
+    out << quint8(values.size());
+    for (const ExportColumn& column : values) {
+        out << column.name << column.dictionary
+            << TsCodec::encodeValues(column.values.constData(), column.values.size());
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        setError(errorText, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+std::optional<SearchPage> read(const QString& path, QString* errorText)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(errorText, file.errorString());
+        return std::nullopt;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint8 category = 0;
+    qint32 rows = 0;
+    in >> magic >> version >> category >> rows;
+    if (magic != kMagic || version != kVersion || category > quint8(SearchCategory::Pet) || rows < 0) {
+        setError(errorText, "내보내기 파일 형식이 맞지 않습니다");
+        return std::nullopt;
+    }
+
+    QByteArray tsData;
+    quint8 columnCount = 0;
+    in >> tsData >> columnCount;
+
+    // 시각은 행마다 최소 1바이트이므로 그보다 많은 행 수는 손상된 헤더
+    if (rows > tsData.size()) {
+        setError(errorText, "내보내기 파일 형식이 맞지 않습니다");
+        return std::nullopt;
+    }
+
+    QVector<qint64> ts;
+    if (!TsCodec::decodeTimestamps(tsData, rows, &ts)) {
+        setError(errorText, "시각 컬럼이 손상되었습니다");
+        return std::nullopt;
+    }
+
+    QVector<ExportColumn> values(columnCount);
+    for (ExportColumn& column : values) {
+        QByteArray data;
+        in >> column.name >> column.dictionary >> data;
+        if (in.status() != QDataStream::Ok || !TsCodec::decodeValues(data, rows, &column.values)) {
+            setError(errorText, "값 컬럼이 손상되었습니다: " + column.name);
+            return std::nullopt;
+        }
+        // 사전 컬럼의 코드가 사전 범위를 벗어나면 표시할 때 잘못된 접근이 된다 (값이 있는데 사전이 비어 있는 경우 포함)
+        if (!isDictionaryColumn(column.name))
+            continue;
+        for (double code : std::as_const(column.values)) {
+            if (code < 0 || code >= column.dictionary.size()) {
+                setError(errorText, "사전 코드가 잘못되었습니다: " + column.name);
+                return std::nullopt;
+            }
+        }
+    }
+
+    std::optional<SearchColumns> columns = fromExportColumns(SearchCategory(category), ts, values);
+    if (!columns) {
+        setError(errorText, "필요한 컬럼이 없습니다");
+        return std::nullopt;
+    }
+
+    SearchPage page;
+    page.category = SearchCategory(category);
+    page.columns = std::move(*columns);
+    return page;
+}
+
+} // namespace SearchExport
@@ -0,0 +1,19 @@
+#ifndef SEARCHEXPORT_H
+#define SEARCHEXPORT_H
+
+#include <QString>
+#include <optional>
+#include "database.h"
+
+// 검색 결과 내보내기 파일 (.hstx)
+// - 시각 컬럼은 delta-of-delta varint, 값 컬럼은 Gorilla XOR 로 압축 (tscodec.h)
+// - 상태 문자열 컬럼은 사전 코드만 압축하고 사전 문자열은 한 번만 저장
+// - 원본 검색 결과만 대상 (구간 집계 결과는 다시 계산할 수 있으므로 내보내지 않음)
+namespace SearchExport {
+
+bool write(const QString& path, SearchCategory category, const SearchColumns& columns, QString* errorText = nullptr);
+std::optional<SearchPage> read(const QString& path, QString* errorText = nullptr);
+
+} // namespace SearchExport
+
+#endif // SEARCHEXPORT_H
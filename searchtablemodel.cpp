@@ -0,0 +1,210 @@
+#include "searchtablemodel.h"
+#include <QDateTime>
+#include <type_traits>
+
+// 펫 기록 1건당 표시 행 수 (급식, 급수, 배변)
+static const int PetRowsPerRecord = 3;
+
+SearchTableModel::SearchTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_category(SearchCategory::HomeEnv)
+    , m_columns(HomeEnvColumns())
+    , m_hasMore(false)
+{
+}
+
+void SearchTableModel::reset(SearchCategory category, bool aggregated)
+{
+    beginResetModel();
+    m_category = category;
+    if (aggregated) {
+        m_columns = AggregateColumns();
+    } else {
+        switch (category) {
+        case SearchCategory::HomeEnv: m_columns = HomeEnvColumns(); break;
+        case SearchCategory::Fire:
+        case SearchCategory::Gas:     m_columns = EventColumns(); break;
+        case SearchCategory::Plant:   m_columns = PlantColumns(); break;
+        case SearchCategory::Pet:     m_columns = PetColumns(); break;
+        }
+    }
+    // 집계 결과는 한 번에 오므로 fetchMore 대상이 아님
+    m_hasMore = !aggregated;
+    endResetModel();
+}
+
+void SearchTableModel::appendPage(const SearchPage& page)
+{
+    m_hasMore = page.hasMore;
+    if (page.category != m_category || page.columns.index() != m_columns.index())
+        return;
+
+    const int added = std::visit([](const auto& columns) { return columns.size(); }, page.columns);
+    if (added == 0)
+        return;
+
+    const int first = rowCount();
+    beginInsertRows(QModelIndex(), first, first + added * rowsPerRecord() - 1);
+    std::visit([&page](auto& columns) {
+        using Columns = std::decay_t<decltype(columns)>;
+        columns.append(std::get<Columns>(page.columns));
+    }, m_columns);
+    endInsertRows();
+}
+
+void SearchTableModel::setHasMore(bool hasMore)
+{
+    m_hasMore = hasMore;
+}
+
+int SearchTableModel::recordCount() const
+{
+    return std::visit([](const auto& columns) { return columns.size(); }, m_columns);
+}
+
+int SearchTableModel::rowsPerRecord() const
+{
+    return m_category == SearchCategory::Pet && !isAggregated() ? PetRowsPerRecord : 1;
+}
+
+bool SearchTableModel::isAggregated() const
+{
+    return std::holds_alternative<AggregateColumns>(m_columns);
+}
+
+int SearchTableModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return recordCount() * rowsPerRecord();
+}
+
+int SearchTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 3;
+}
+
+QVariant SearchTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const int row = index.row();
+    const int record = row / rowsPerRecord();
+    if (record >= recordCount())
+        return QVariant();
+
+    switch (index.column()) {
+    case 0:
+        // 날짜시간 epoch ms -> "2025-09-10 11:27" (로컬 시간)
+        return QDateTime::fromMSecsSinceEpoch(timestamp(record)).toString("yyyy-MM-dd hh:mm");
+    case 1:
+        return categoryText(row);
+    case 2:
+        return valueText(record, row);
+    }
+    return QVariant();
+}
+
+QVariant SearchTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case 0: return QString("날짜");
+    case 1: return QString("분류");
+    case 2: return QString("값");
+    }
+    return QVariant();
+}
+
+bool SearchTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_hasMore;
+}
+
+void SearchTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (canFetchMore(parent))
+        emit moreRequested();
+}
+
+qint64 SearchTableModel::timestamp(int record) const
+{
+    return std::visit([record](const auto& columns) { return columns.ts[record]; }, m_columns);
+}
+
+QString SearchTableModel::categoryText(int row) const
+{
+    QString label;
+    switch (m_category) {
+    case SearchCategory::HomeEnv: label = "온도"; break;
+    case SearchCategory::Fire:    label = "화재"; break;
+    case SearchCategory::Gas:     label = "가스"; break;
+    case SearchCategory::Plant:   label = "식물"; break;
+    case SearchCategory::Pet:
+        switch (row % PetRowsPerRecord) {
+        case 0:  return "펫(급식)";
+        case 1:  return "펫(급수)";
+        default: return "펫(배변)";
+        }
+    }
+
+    if (!isAggregated())
+        return label;
+
+    // 집계 결과는 구간 크기를 함께 표시 (예: "온도 (1시간)")
+    const qint64 bucketMs = std::get<AggregateColumns>(m_columns).bucketMs;
+    if (bucketMs >= 24LL * 60 * 60 * 1000)
+        return label + " (1일)";
+    if (bucketMs >= 60LL * 60 * 1000)
+        return label + " (1시간)";
+    return label + " (1분)";
+}
+
+QString SearchTableModel::valueText(int record, int row) const
+{
+    if (isAggregated()) {
+        // 값 (구간 평균, 최소/최대)
+        const AggregateColumns& agg = std::get<AggregateColumns>(m_columns);
+        QString unit;
+        if (m_category == SearchCategory::HomeEnv)
+            unit = "°C";
+        else if (m_category == SearchCategory::Plant)
+            unit = "%";
+        return QString("평균 %1%4 (최소 %2 / 최대 %3)")
+            .arg(QString::number(agg.avg[record], 'f', 1),
+                 QString::number(agg.min[record]),
+                 QString::number(agg.max[record]),
+                 unit);
+    }
+
+    switch (m_category) {
+    case SearchCategory::HomeEnv: {
+        // 값 (온도)
+        const HomeEnvColumns& home = std::get<HomeEnvColumns>(m_columns);
+        return QString::number(home.temperature[record]) + "°C";
+    }
+    case SearchCategory::Fire:
+    case SearchCategory::Gas: {
+        // 값 (상태 + 수치)
+        const EventColumns& events = std::get<EventColumns>(m_columns);
+        return events.statusNames.value(events.status[record]) + " (" + QString::number(events.level[record]) + ")";
+    }
+    case SearchCategory::Plant: {
+        // 값 (토양습도)
+        const PlantColumns& plant = std::get<PlantColumns>(m_columns);
+        return QString::number(plant.soilMoisture[record]) + "%";
+    }
+    case SearchCategory::Pet: {
+        const PetColumns& pet = std::get<PetColumns>(m_columns);
+        switch (row % PetRowsPerRecord) {
+        case 0:  return pet.names.value(pet.food[record]);
+        case 1:  return pet.names.value(pet.water[record]);
+        default: return pet.names.value(pet.toilet[record]);
+        }
+    }
+    }
+    return QString();
+}
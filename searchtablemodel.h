@@ -0,0 +1,50 @@
+#ifndef SEARCHTABLEMODEL_H
+#define SEARCHTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include "database.h"
+
+// Search 결과 테이블 모델 (날짜 / 분류 / 값)
+// - 받은 페이지의 컬럼 배열을 그대로 들고 있고, 셀 문자열은 data() 에서 보이는 행만 만든다
+// - 스크롤이 끝에 닿으면 뷰가 fetchMore() 를 호출하고, 모델은 moreRequested() 로 다음 페이지를 요청한다
+// - 펫 기록 1건은 급식/급수/배변 3행으로 보여준다
+// - 구간 집계 결과는 구간당 1행 (평균, 최소/최대)
+class SearchTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit SearchTableModel(QObject *parent = nullptr);
+
+    // 새 검색 시작 - 기존 행을 비우고 카테고리 지정 (aggregated 면 구간 집계 결과를 받음)
+    void reset(SearchCategory category, bool aggregated = false);
+    // 다음 페이지를 뒤에 이어 붙임 (page.category 가 현재 카테고리와 같아야 함)
+    void appendPage(const SearchPage& page);
+    // 더 받을 페이지가 없음을 표시 (조회 실패 시)
+    void setHasMore(bool hasMore);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+signals:
+    void moreRequested();
+
+private:
+    int recordCount() const;
+    int rowsPerRecord() const;
+    bool isAggregated() const;
+    QString categoryText(int row) const;
+    QString valueText(int record, int row) const;
+    qint64 timestamp(int record) const;
+
+    SearchCategory m_category;
+    SearchColumns m_columns;
+    bool m_hasMore;
+};
+
+#endif // SEARCHTABLEMODEL_H
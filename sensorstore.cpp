@@ -0,0 +1,417 @@
+#include "sensorstore.h"
+#include "tscodec.h"
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+#include <QScopeGuard>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char kMagic[4] = { 'H', 'S', 'T', 'S' };
+const char kBlockMagic[4] = { 'H', 'S', 'T', 'B' };
+const quint32 kVersion = 1;
+
+// 원본은 <이름>.hsts, 압축 블록은 <이름>.hstb
+QString fileName(int sensor, const char* extension)
+{
+    static const char* names[] = { "plant", "gas", "fire", "pet" };
+    return QString("%1.%2").arg(names[sensor], extension);
+}
+
+} // namespace
+
+SensorStore& SensorStore::instance()
+{
+    static SensorStore store;
+    return store;
+}
+
+SensorStore::~SensorStore()
+{
+    close();
+}
+
+bool SensorStore::open(const QString& dir)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_open)
+        return true;
+
+    if (!QDir().mkpath(dir)) {
+        qWarning() << "센서 저장소 폴더 생성 실패:" << dir;
+        return false;
+    }
+
+    for (int i = 0; i < static_cast<int>(Sensor::Count); ++i) {
+        if (!openSeries(m_series[i], QDir(dir).filePath(fileName(i, "hsts")))
+            || !openBlocks(m_series[i], QDir(dir).filePath(fileName(i, "hstb")))) {
+            locker.unlock();
+            close();
+            return false;
+        }
+    }
+
+    m_open = true;
+    qDebug() << "센서 저장소 열림:" << dir;
+    return true;
+}
+
+void SensorStore::close()
+{
+    // 진행 중인 압축은 잠금을 다시 잡으므로 잠그기 전에 끝날 때까지 기다린다
+    m_compactor.stop();
+
+    QMutexLocker locker(&m_mutex);
+    for (Series& series : m_series) {
+        if (series.map)
+            series.file.unmap(series.map);
+        series.map = nullptr;
+        series.file.close();
+        series.capacity = 0;
+        series.count = 0;
+        series.sparseIndex.clear();
+        series.blockFile.close();
+        series.blocks.clear();
+        series.blockRecords = 0;
+        series.compacting = false;
+    }
+    m_open = false;
+}
+
+bool SensorStore::isOpen() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_open;
+}
+
+bool SensorStore::openSeries(Series& series, const QString& path)
+{
+    series.file.setFileName(path);
+    if (!series.file.open(QIODevice::ReadWrite)) {
+        qWarning() << "센서 파일 열기 실패:" << path << series.file.errorString();
+        return false;
+    }
+
+    const bool created = series.file.size() < qint64(sizeof(Header));
+    if (created) {
+        Header fresh = {};
+        std::memcpy(fresh.magic, kMagic, sizeof(kMagic));
+        fresh.version = kVersion;
+        fresh.recordSize = sizeof(Record);
+        series.file.resize(0);
+        series.file.write(reinterpret_cast<const char*>(&fresh), sizeof(fresh));
+        series.file.flush();
+    }
+
+    const qint64 capacity = (series.file.size() - qint64(sizeof(Header))) / qint64(sizeof(Record));
+    if (!remap(series, qMax(capacity, GrowRecords)))
+        return false;
+
+    const Header* head = header(series);
+    if (std::memcmp(head->magic, kMagic, sizeof(kMagic)) != 0
+        || head->version != kVersion || head->recordSize != sizeof(Record)) {
+        qWarning() << "센서 파일 형식이 맞지 않음:" << path;
+        return false;
+    }
+
+    // 비정상 종료로 count 가 용량을 넘는 경우 방어
+    series.count = qBound<qint64>(0, head->count, series.capacity);
+
+    rebuildSparseIndex(series);
+    return true;
+}
+
+bool SensorStore::openBlocks(Series& series, const QString& path)
+{
+    series.blockFile.setFileName(path);
+    if (!series.blockFile.open(QIODevice::ReadWrite)) {
+        qWarning() << "압축 블록 파일 열기 실패:" << path << series.blockFile.errorString();
+        return false;
+    }
+
+    // 블록 머리만 읽어 목록을 만든다 (압축 데이터는 조회할 때 읽음)
+    const qint64 size = series.blockFile.size();
+    qint64 offset = 0;
+    series.blocks.clear();
+    series.blockRecords = 0;
+    while (offset + qint64(sizeof(BlockHeader)) <= size) {
+        Block block;
+        block.offset = offset;
+        series.blockFile.seek(offset);
+        if (series.blockFile.read(reinterpret_cast<char*>(&block.header), sizeof(BlockHeader)) != sizeof(BlockHeader))
+            break;
+        const qint64 next = offset + qint64(sizeof(BlockHeader)) + block.header.tsBytes + block.header.valueBytes;
+        if (std::memcmp(block.header.magic, kBlockMagic, sizeof(kBlockMagic)) != 0 || next > size)
+            break;
+        series.blocks.append(block);
+        series.blockRecords += block.header.count;
+        offset = next;
+    }
+
+    // 압축 도중 비정상 종료로 끝에 남은 반쪽 블록은 잘라낸다
+    if (offset < size) {
+        qWarning() << "압축 블록 파일 끝의 손상된 블록 제거:" << path;
+        series.blockFile.resize(offset);
+    }
+
+    // 블록을 쓴 뒤 원본을 비우기 전에 죽었다면, 이미 블록에 있는 레코드를 원본에서 뺀다
+    if (!series.blocks.isEmpty()) {
+        const BlockHeader& last = series.blocks.last().header;
+        const qint64 blockEnd = last.firstSeq + last.count;
+        const qint64 baseSeq = header(series)->baseSeq;
+        if (blockEnd > baseSeq)
+            dropRecords(series, qMin(series.count, blockEnd - baseSeq));
+        else if (blockEnd < baseSeq)
+            qWarning() << "압축 블록 뒤에 빠진 레코드가 있음:" << path << (baseSeq - blockEnd) << "개";
+    }
+    return true;
+}
+
+void SensorStore::rebuildSparseIndex(Series& series)
+{
+    // IndexStride 번째 레코드만 읽는다
+    const Record* recs = records(series);
+    series.sparseIndex.clear();
+    for (qint64 i = 0; i < series.count; i += IndexStride)
+        series.sparseIndex.append(recs[i].tsMs);
+}
+
+bool SensorStore::compact(int sensor)
+{
+    QMutexLocker locker(&m_mutex);
+    Series& series = m_series[sensor];
+    const auto finished = qScopeGuard([&series]() { series.compacting = false; });
+    if (!m_open)
+        return false;
+
+    // 압축할 앞부분만 복사해 두고 잠금을 푼다 - 그동안 append/query 는 그대로 진행
+    // (앞부분은 압축이 끝나 dropRecords 하기 전까지 바뀌지 않는다)
+    const qint64 full = (series.count / BlockRecords) * BlockRecords;
+    if (full == 0)
+        return false;
+    const qint64 baseSeq = header(series)->baseSeq;
+    QVector<Record> recs(full);
+    std::memcpy(recs.data(), records(series), full * qint64(sizeof(Record)));
+    locker.unlock();
+
+    QByteArray data;
+    QVector<Block> written;
+    QVector<qint64> ts(BlockRecords);
+    QVector<double> values(BlockRecords);
+    for (qint64 begin = 0; begin < full; begin += BlockRecords) {
+        for (int i = 0; i < BlockRecords; ++i) {
+            ts[i] = recs[begin + i].tsMs;
+            values[i] = recs[begin + i].value;
+        }
+        const QByteArray tsData = TsCodec::encodeTimestamps(ts.constData(), BlockRecords);
+        const QByteArray valueData = TsCodec::encodeValues(values.constData(), BlockRecords);
+
+        Block block;
+        block.offset = data.size();     // 블록 파일 끝 기준 - 쓸 때 더한다
+        block.header = {};
+        std::memcpy(block.header.magic, kBlockMagic, sizeof(kBlockMagic));
+        block.header.count = BlockRecords;
+        block.header.firstSeq = baseSeq + begin;
+        block.header.firstTs = ts.first();
+        block.header.lastTs = ts.last();
+        block.header.tsBytes = quint32(tsData.size());
+        block.header.valueBytes = quint32(valueData.size());
+
+        data.append(reinterpret_cast<const char*>(&block.header), sizeof(BlockHeader));
+        data.append(tsData);
+        data.append(valueData);
+        written.append(block);
+    }
+
+    locker.relock();
+    if (!m_open)
+        return false;
+
+    // 남은 레코드를 앞으로 옮길 때 원래 자리와 겹치면 옮기는 도중 죽었을 때 복구할 수 없다
+    // 압축하는 동안 그만큼 쌓이는 일은 거의 없으므로 이번 압축은 버리고 다음 append 때 다시 시도
+    if (series.count - full > full) {
+        qWarning() << "압축 중 원본이 너무 많이 늘어 다음에 다시 압축:" << series.file.fileName();
+        return false;
+    }
+
+    // 블록을 먼저 블록 파일에 쓰고 내려보낸 뒤에 원본에서 뺀다
+    const qint64 start = series.blockFile.size();
+    if (!series.blockFile.seek(start) || series.blockFile.write(data) != data.size() || !series.blockFile.flush()) {
+        qWarning() << "압축 블록 쓰기 실패:" << series.blockFile.fileName() << series.blockFile.errorString();
+        series.blockFile.resize(start);
+        return false;
+    }
+
+    for (Block& block : written)
+        block.offset += start;
+    series.blocks += written;
+    series.blockRecords += full;
+    dropRecords(series, full);
+    return true;
+}
+
+void SensorStore::dropRecords(Series& series, qint64 count)
+{
+    if (count <= 0)
+        return;
+
+    // 남은 레코드를 앞으로 옮긴 뒤 머리(count, baseSeq)를 한 번에 갱신한다
+    // 앞쪽 count 개는 이미 압축 블록에 있으므로 덮어써도 되고, remaining <= count 이면 옮기는 범위가 원래 자리와
+    // 겹치지 않아 도중에 죽어도 원래 자리의 레코드가 남는다 - 다시 열 때 openBlocks 가 같은 이동을 반복한다
+    const qint64 remaining = series.count - count;
+    if (remaining > 0) {
+        uchar* base = series.map + sizeof(Header);
+        std::memmove(base, base + count * qint64(sizeof(Record)), remaining * qint64(sizeof(Record)));
+    }
+
+    Header updated = *header(series);
+    updated.count = remaining;
+    updated.baseSeq += count;
+    std::memcpy(header(series), &updated, sizeof(Header));
+
+    series.count = remaining;
+    rebuildSparseIndex(series);
+}
+
+bool SensorStore::remap(Series& series, qint64 capacity)
+{
+    if (series.map) {
+        series.file.unmap(series.map);
+        series.map = nullptr;
+    }
+
+    const qint64 bytes = qint64(sizeof(Header)) + capacity * qint64(sizeof(Record));
+    if (series.file.size() < bytes && !series.file.resize(bytes)) {
+        qWarning() << "센서 파일 확장 실패:" << series.file.fileName() << series.file.errorString();
+        return false;
+    }
+
+    series.map = series.file.map(0, bytes);
+    if (!series.map) {
+        qWarning() << "센서 파일 매핑 실패:" << series.file.fileName() << series.file.errorString();
+        return false;
+    }
+    series.capacity = capacity;
+    return true;
+}
+
+SensorStore::Header* SensorStore::header(const Series& series)
+{
+    return reinterpret_cast<Header*>(series.map);
+}
+
+const SensorStore::Record* SensorStore::records(const Series& series)
+{
+    return reinterpret_cast<const Record*>(series.map + sizeof(Header));
+}
+
+void SensorStore::append(Sensor sensor, double value)
+{
+    append(sensor, QDateTime::currentMSecsSinceEpoch(), value);
+}
+
+void SensorStore::append(Sensor sensor, qint64 tsMs, double value)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_open)
+        return;
+
+    Series& series = m_series[static_cast<int>(sensor)];
+    // 원본이 충분히 쌓였으면 작업 스레드에서 압축 블록으로 옮겨 비운다 (그동안과 실패 시에는 원본 파일을 늘려서 계속 기록)
+    if (series.count >= CompactRecords && !series.compacting) {
+        series.compacting = true;
+        m_compactor.run([this, sensor]() { return compact(static_cast<int>(sensor)); });
+    }
+    if (series.count == series.capacity && !remap(series, series.capacity + GrowRecords))
+        return;
+
+    // 시각 순서가 유지되어야 이분 탐색이 가능하므로, 시계가 뒤로 간 경우 직전 시각에 맞춘다
+    const Record* recs = records(series);
+    if (series.count > 0)
+        tsMs = qMax(tsMs, recs[series.count - 1].tsMs);
+    else if (!series.blocks.isEmpty())
+        tsMs = qMax(tsMs, series.blocks.last().header.lastTs);
+
+    // 레코드를 먼저 쓰고 count 를 나중에 갱신해야 중간에 죽어도 반쯤 쓴 레코드가 보이지 않는다
+    Record record = { tsMs, value };
+    std::memcpy(series.map + sizeof(Header) + series.count * qint64(sizeof(Record)), &record, sizeof(record));
+    if (series.count % IndexStride == 0)
+        series.sparseIndex.append(tsMs);
+    ++series.count;
+    header(series)->count = series.count;
+}
+
+qint64 SensorStore::lowerBound(const Series& series, qint64 tsMs) const
+{
+    // 희소 인덱스로 블록을 찾고, 블록 안에서 다시 이분 탐색
+    auto block = std::lower_bound(series.sparseIndex.cbegin(), series.sparseIndex.cend(), tsMs);
+    const qint64 blockIndex = qMax<qint64>(0, (block - series.sparseIndex.cbegin()) - 1);
+    const qint64 begin = blockIndex * IndexStride;
+    const qint64 end = qMin(series.count, begin + 2 * IndexStride);
+
+    const Record* recs = records(series);
+    const Record* found = std::lower_bound(recs + begin, recs + end, tsMs,
+                                           [](const Record& r, qint64 ts) { return r.tsMs < ts; });
+    return found - recs;
+}
+
+QVector<SensorStore::Record> SensorStore::query(Sensor sensor, qint64 firstMs, qint64 lastMs, int limit) const
+{
+    QVector<Record> result;
+    QMutexLocker locker(&m_mutex);
+    if (!m_open || firstMs > lastMs)
+        return result;
+
+    const Series& series = m_series[static_cast<int>(sensor)];
+    const auto full = [&result, limit]() { return limit >= 0 && result.size() >= limit; };
+
+    // 원본(최신 구간): lastMs 보다 큰 첫 레코드 직전부터 거꾸로 읽어 최신순으로 반환
+    if (series.count > 0) {
+        const qint64 endIndex = lastMs == std::numeric_limits<qint64>::max() ? series.count
+                                                                              : lowerBound(series, lastMs + 1);
+        const qint64 beginIndex = lowerBound(series, firstMs);
+        const Record* recs = records(series);
+        for (qint64 i = endIndex - 1; i >= beginIndex && !full(); --i)
+            result.append(recs[i]);
+    }
+
+    // 압축 블록(과거 구간): 범위에 걸치는 블록만 풀어서 최신 블록부터
+    QVector<qint64> ts;
+    QVector<double> values;
+    for (auto block = series.blocks.crbegin(); block != series.blocks.crend() && !full(); ++block) {
+        if (block->header.lastTs < firstMs)
+            break;
+        if (block->header.firstTs > lastMs)
+            continue;
+
+        ts.clear();
+        values.clear();
+        if (!readBlock(series, *block, &ts, &values)) {
+            qWarning() << "압축 블록 읽기 실패:" << series.blockFile.fileName() << block->offset;
+            continue;
+        }
+        for (int i = ts.size() - 1; i >= 0 && !full(); --i) {
+            if (ts[i] >= firstMs && ts[i] <= lastMs)
+                result.append(Record{ ts[i], values[i] });
+        }
+    }
+    return result;
+}
+
+bool SensorStore::readBlock(const Series& series, const Block& block, QVector<qint64>* ts, QVector<double>* values)
+{
+    const BlockHeader& head = block.header;
+    if (!series.blockFile.seek(block.offset + qint64(sizeof(BlockHeader))))
+        return false;
+
+    const QByteArray tsData = series.blockFile.read(head.tsBytes);
+    const QByteArray valueData = series.blockFile.read(head.valueBytes);
+    if (tsData.size() != qint64(head.tsBytes) || valueData.size() != qint64(head.valueBytes))
+        return false;
+    return TsCodec::decodeTimestamps(tsData, int(head.count), ts)
+        && TsCodec::decodeValues(valueData, int(head.count), values);
+}
@@ -0,0 +1,126 @@
+#ifndef SENSORSTORE_H
+#define SENSORSTORE_H
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <array>
+#include "dbworker.h"
+
+// 로컬 센서 기록 저장소 (센서별 append-only 파일)
+// - TCP 로 받은 센서 값을 고정 길이 레코드(시각 ms + 값)로 파일 끝에 추가
+// - 파일은 메모리 매핑해서 쓰고 읽으며, 용량이 차면 GrowRecords 만큼 늘려 다시 매핑
+// - IndexStride 개마다 시각을 메모리에 들고 있는 희소 인덱스로 범위 시작 위치를 찾는다
+// - 원본 파일이 CompactRecords 개로 차면 BlockRecords 개씩 압축 블록 파일(.hstb)로 옮기고 원본은 비운다
+//   (시각 delta-of-delta + 값 XOR 압축, tscodec.h) - 1년치 기록도 원본의 1/10 이하로 유지
+// - 압축은 작업 스레드에서 진행하고, 그동안 append 는 원본 파일을 늘려 가며 계속 기록한다
+// - DB 가 내려가 있을 때 Search 가 이 저장소를 대신 조회한다
+class SensorStore
+{
+public:
+    enum class Sensor
+    {
+        Plant,  // 토양수분 (%)
+        Gas,    // 가스 수치
+        Fire,   // 화재 센서 수치
+        Pet,    // 배변 감지 (1 = 감지, 0 = 없음)
+        Count
+    };
+
+    // 디스크 레코드 - 크기가 바뀌면 파일 형식 버전도 올릴 것
+    struct Record
+    {
+        qint64 tsMs;
+        double value;
+    };
+    static_assert(sizeof(Record) == 16, "SensorStore::Record 는 16바이트 고정");
+
+    static SensorStore& instance();
+
+    // dir 아래에 센서별 파일을 열거나 만든다
+    bool open(const QString& dir);
+    void close();
+    bool isOpen() const;
+
+    // 현재 시각으로 값 추가
+    void append(Sensor sensor, double value);
+    void append(Sensor sensor, qint64 tsMs, double value);
+
+    // [firstMs, lastMs] 범위 레코드를 최신순으로 (최대 limit 개)
+    QVector<Record> query(Sensor sensor, qint64 firstMs, qint64 lastMs, int limit = -1) const;
+
+private:
+    SensorStore() = default;
+    ~SensorStore();
+
+    SensorStore(const SensorStore&) = delete;
+    SensorStore& operator=(const SensorStore&) = delete;
+
+    struct Header
+    {
+        char magic[4];          // "HSTS"
+        quint32 version;
+        quint32 recordSize;
+        quint32 reserved;
+        qint64 count;           // 기록된 레코드 수 (레코드를 쓴 뒤에 갱신)
+        qint64 baseSeq;         // 첫 레코드의 일련번호 (그 앞은 모두 압축 블록에 있음)
+    };
+    static_assert(sizeof(Header) == 32, "SensorStore::Header 는 32바이트 고정");
+
+    // 압축 블록 파일의 블록 머리 - 뒤에 시각/값 압축 데이터가 이어진다
+    struct BlockHeader
+    {
+        char magic[4];          // "HSTB"
+        quint32 count;
+        qint64 firstSeq;
+        qint64 firstTs;
+        qint64 lastTs;
+        quint32 tsBytes;
+        quint32 valueBytes;
+    };
+    static_assert(sizeof(BlockHeader) == 40, "SensorStore::BlockHeader 는 40바이트 고정");
+
+    // 메모리에 들고 있는 블록 목록 (데이터는 조회할 때만 읽어서 푼다)
+    struct Block
+    {
+        qint64 offset;          // 블록 파일 안의 BlockHeader 위치
+        BlockHeader header;
+    };
+
+    struct Series
+    {
+        QFile file;
+        uchar* map = nullptr;
+        qint64 capacity = 0;            // 매핑된 레코드 수
+        qint64 count = 0;
+        QVector<qint64> sparseIndex;    // IndexStride 번째 레코드마다의 시각
+        mutable QFile blockFile;        // 조회 중에도 seek/read 하므로 mutable
+        QVector<Block> blocks;
+        qint64 blockRecords = 0;        // 압축 블록에 든 레코드 수
+        bool compacting = false;        // 작업 스레드에 압축을 맡겨 둔 상태
+    };
+
+    static constexpr int IndexStride = 256;
+    static constexpr qint64 GrowRecords = 64 * 1024;
+    static constexpr qint64 CompactRecords = GrowRecords;
+    static constexpr int BlockRecords = 4096;
+
+    bool openSeries(Series& series, const QString& path);
+    bool openBlocks(Series& series, const QString& path);
+    bool remap(Series& series, qint64 capacity);
+    bool compact(int sensor);
+    void dropRecords(Series& series, qint64 count);
+    void rebuildSparseIndex(Series& series);
+    static bool readBlock(const Series& series, const Block& block, QVector<qint64>* ts, QVector<double>* values);
+    static Header* header(const Series& series);
+    static const Record* records(const Series& series);
+    qint64 lowerBound(const Series& series, qint64 tsMs) const;
+
+    mutable QMutex m_mutex;
+    std::array<Series, static_cast<int>(Sensor::Count)> m_series;
+    bool m_open = false;
+    DbWorker m_compactor;   // 압축 블록 인코딩/쓰기 전용 스레드 (GUI 스레드의 append 를 막지 않도록)
+};
+
+#endif // SENSORSTORE_H
@@ -1,31 +1,166 @@
 #include "tcpclient.h"
+#include "protocol.h"
+#include "profiler.h"
 #include <QDebug>
+#include <utility>
 
+//=============================================================================
+// TcpClient - GUI 스레드 쪽 창구
+//=============================================================================
 TcpClient::TcpClient(QObject *parent)
     : QObject(parent)
+    , connected_(false)
+    , binaryFraming_(false)
+    , worker_(new TcpClientWorker(&connected_, &binaryFraming_))
+{
+    qRegisterMetaType<TcpEventBatch>();
+
+    // 작업자 시그널은 네트워크 스레드에서 발생하므로 GUI 스레드로 큐 연결
+    connect(worker_, &TcpClientWorker::eventsReceived, this, &TcpClient::eventsReceived);
+    connect(worker_, &TcpClientWorker::connected, this, &TcpClient::connected);
+    connect(worker_, &TcpClientWorker::disconnected, this, &TcpClient::disconnected);
+    connect(worker_, &TcpClientWorker::errorOccurred, this, &TcpClient::errorOccurred);
+
+    thread_.setObjectName("TcpClient");
+    worker_->moveToThread(&thread_);
+    // 작업자(소켓/타이머 포함)는 자기 스레드에서 지운다 - 스레드가 끝날 때 지연 삭제가 처리됨
+    connect(&thread_, &QThread::finished, worker_, &QObject::deleteLater);
+    thread_.start();
+}
+
+TcpClient::~TcpClient()
+{
+    // 소켓은 네트워크 스레드에서 닫고 (최대 ShutdownWaitMs) 스레드를 끝낸다 - 작업자는 finished 에서 deleteLater 로 정리됨
+    QMetaObject::invokeMethod(worker_, &TcpClientWorker::shutdown, Qt::BlockingQueuedConnection);
+    thread_.quit();
+    thread_.wait();
+}
+
+void TcpClient::connectToServer(const QString& host, quint16 port)
+{
+    TcpClientWorker* worker = worker_;
+    QMetaObject::invokeMethod(worker, [worker, host, port]() {
+        worker->connectToServer(host, port);
+    }, Qt::QueuedConnection);
+}
+
+void TcpClient::disconnectFromHost()
+{
+    QMetaObject::invokeMethod(worker_, &TcpClientWorker::disconnectFromHost, Qt::QueuedConnection);
+}
+
+void TcpClient::sendMessage(const QString& message)
+{
+    TcpClientWorker* worker = worker_;
+    QMetaObject::invokeMethod(worker, [worker, message]() {
+        worker->sendMessage(message);
+    }, Qt::QueuedConnection);
+}
+
+bool TcpClient::isConnected() const
+{
+    return connected_.load(std::memory_order_acquire);
+}
+
+void TcpClient::setAutoReconnect(bool enabled, int initialDelayMs, int maxDelayMs)
+{
+    TcpClientWorker* worker = worker_;
+    QMetaObject::invokeMethod(worker, [worker, enabled, initialDelayMs, maxDelayMs]() {
+        worker->setAutoReconnect(enabled, initialDelayMs, maxDelayMs);
+    }, Qt::QueuedConnection);
+}
+
+void TcpClient::setBinaryFraming(bool enabled)
+{
+    TcpClientWorker* worker = worker_;
+    QMetaObject::invokeMethod(worker, [worker, enabled]() {
+        worker->setBinaryFraming(enabled);
+    }, Qt::QueuedConnection);
+}
+
+bool TcpClient::isBinaryFraming() const
+{
+    return binaryFraming_.load(std::memory_order_acquire);
+}
+
+// 창문 제어 명령 메서드들 (서버 문서의 TCP 명령어 사용)
+void TcpClient::sendWindowOpen()
+{
+    sendMessage("window_open");
+}
+
+void TcpClient::sendWindowClose()
+{
+    sendMessage("window_close");
+}
+
+void TcpClient::sendWindowStatus()
+{
+    sendMessage("window_status");
+}
+
+void TcpClient::setWindowAngle(int angle)
+{
+    QString command = QString("set_open_angle=%1").arg(angle);
+    sendMessage(command);
+}
+
+//=============================================================================
+// TcpClientWorker - 네트워크 스레드
+//=============================================================================
+TcpClientWorker::TcpClientWorker(std::atomic<bool>* connected, std::atomic<bool>* binaryFraming)
+    : QObject(nullptr)
     , socket_(new QTcpSocket(this))
     , host_("127.0.0.1")
     , port_(8080)  // 서버 문서에 명시된 포트
+    , reconnectTimer_(new QTimer(this))
+    , autoReconnect_(false)
+    , initialDelayMs_(500)
+    , maxDelayMs_(30000)
+    , reconnectDelayMs_(500)
+    , preferBinary_(false)
+    , framing_(Framing::Text)
+    , negotiateTimer_(new QTimer(this))
+    , connected_(connected)
+    , binaryFraming_(binaryFraming)
 {
     // 시그널 연결
-    connect(socket_, &QTcpSocket::readyRead, this, &TcpClient::onReadyRead);
-    connect(socket_, &QTcpSocket::disconnected, this, &TcpClient::onDisconnected);
+    connect(socket_, &QTcpSocket::readyRead, this, &TcpClientWorker::onReadyRead);
+    connect(socket_, &QTcpSocket::disconnected, this, &TcpClientWorker::onDisconnected);
     connect(socket_, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::errorOccurred),
-            this, &TcpClient::onErrorOccurred);
-    connect(socket_, &QTcpSocket::connected, this, &TcpClient::onConnected);
+            this, &TcpClientWorker::onErrorOccurred);
+    connect(socket_, &QTcpSocket::connected, this, &TcpClientWorker::onConnected);
+
+    reconnectTimer_->setSingleShot(true);
+    connect(reconnectTimer_, &QTimer::timeout, this, [this]() {
+        connectToServer(host_, port_);
+    });
+
+    negotiateTimer_->setSingleShot(true);
+    connect(negotiateTimer_, &QTimer::timeout, this, [this]() {
+        qInfo() << "Server did not accept binary framing, using text protocol";
+        finishNegotiation(Framing::Text);
+        processBuffer();  // 협상 중 보류한 개행 없는 메시지
+    });
 }
 
-TcpClient::~TcpClient()
+void TcpClientWorker::shutdown()
 {
+    autoReconnect_ = false;
+    reconnectTimer_->stop();
+    negotiateTimer_->stop();
+    // 앱 종료를 막지 않도록 남은 송신분은 잠깐만 기다리고, 그래도 안 닫히면 끊어 버린다
     if (socket_->state() == QTcpSocket::ConnectedState) {
         socket_->disconnectFromHost();
-        if (socket_->state() != QTcpSocket::UnconnectedState) {
-            socket_->waitForDisconnected(3000);
-        }
+        if (socket_->state() != QTcpSocket::UnconnectedState && !socket_->waitForDisconnected(ShutdownWaitMs))
+            socket_->abort();
+    } else {
+        socket_->abort();  // 연결 시도 중이면 바로 취소
     }
+    connected_->store(false, std::memory_order_release);
 }
 
-void TcpClient::connectToServer(const QString& host, quint16 port)
+void TcpClientWorker::connectToServer(const QString& host, quint16 port)
 {
     host_ = host;
     port_ = port;
@@ -44,8 +179,37 @@ void TcpClient::connectToServer(const QString& host, quint16 port)
     socket_->connectToHost(host_, port_);
 }
 
-void TcpClient::disconnectFromHost()
+void TcpClientWorker::setAutoReconnect(bool enabled, int initialDelayMs, int maxDelayMs)
+{
+    autoReconnect_ = enabled;
+    initialDelayMs_ = initialDelayMs;
+    maxDelayMs_ = qMax(initialDelayMs, maxDelayMs);
+    reconnectDelayMs_ = initialDelayMs_;
+    if (!enabled)
+        reconnectTimer_->stop();
+}
+
+void TcpClientWorker::scheduleReconnect()
 {
+    // 끊김은 errorOccurred 와 disconnected 가 함께 오므로 이미 예약돼 있으면 무시
+    if (!autoReconnect_ || reconnectTimer_->isActive() || socket_->state() == QTcpSocket::ConnectedState)
+        return;
+
+    qInfo() << "Reconnecting in" << reconnectDelayMs_ << "ms";
+    reconnectTimer_->start(reconnectDelayMs_);
+    reconnectDelayMs_ = qMin(reconnectDelayMs_ * 2, maxDelayMs_);
+}
+
+void TcpClientWorker::setBinaryFraming(bool enabled)
+{
+    preferBinary_ = enabled;
+}
+
+void TcpClientWorker::disconnectFromHost()
+{
+    autoReconnect_ = false;
+    reconnectTimer_->stop();
+
     if (socket_->state() == QTcpSocket::ConnectedState) {
         qInfo() << "Disconnecting from server";
         socket_->disconnectFromHost();
@@ -54,7 +218,7 @@ void TcpClient::disconnectFromHost()
     }
 }
 
-void TcpClient::sendMessage(const QString& message)
+void TcpClientWorker::sendMessage(const QString& message)
 {
     if (socket_->state() != QTcpSocket::ConnectedState) {
         qWarning() << "Not connected to server";
@@ -62,8 +226,21 @@ void TcpClient::sendMessage(const QString& message)
         return;
     }
 
-    QByteArray data = message.toUtf8();
-    // 서버 문서에 따라 메시지 끝에 개행 추가하지 않음
+    if (framing_ == Framing::Negotiating) {
+        pendingMessages_.append(message);
+        return;
+    }
+
+    if (framing_ == Framing::Binary) {
+        writeData(Protocol::encodeMessage(message.toUtf8()), message);
+    } else {
+        // 서버 문서에 따라 메시지 끝에 개행 추가하지 않음
+        writeData(message.toUtf8(), message);
+    }
+}
+
+void TcpClientWorker::writeData(const QByteArray& data, const QString& message)
+{
     qint64 bytesWritten = socket_->write(data);
     socket_->flush(); // 즉시 전송 보장
 
@@ -75,73 +252,95 @@ void TcpClient::sendMessage(const QString& message)
     }
 }
 
-// 창문 제어 명령 메서드들 (서버 문서의 TCP 명령어 사용)
-void TcpClient::sendWindowOpen()
+void TcpClientWorker::finishNegotiation(Framing framing)
 {
-    sendMessage("window_open");
-}
+    negotiateTimer_->stop();
+    framing_ = framing;
+    binaryFraming_->store(framing == Framing::Binary, std::memory_order_release);
+    parser_.setMode(framing == Framing::Binary ? ProtocolParser::Mode::Binary : ProtocolParser::Mode::Text);
+    parser_.setFlushPartialLines(framing == Framing::Text);
 
-void TcpClient::sendWindowClose()
-{
-    sendMessage("window_close");
+    const QList<QString> pending = std::exchange(pendingMessages_, {});
+    for (const QString& message : pending)
+        sendMessage(message);
 }
 
-void TcpClient::sendWindowStatus()
+void TcpClientWorker::onReadyRead()
 {
-    sendMessage("window_status");
-}
-
-void TcpClient::setWindowAngle(int angle)
-{
-    QString command = QString("set_open_angle=%1").arg(angle);
-    sendMessage(command);
-}
+    PROFILE_SCOPE("TcpClientWorker::onReadyRead");
+    // 소켓에서 파서 버퍼로 바로 읽어 넣음 (중간 QByteArray 없음)
+    const qint64 available = socket_->bytesAvailable();
+    if (available <= 0)
+        return;
 
-bool TcpClient::isConnected() const
-{
-    return socket_->state() == QTcpSocket::ConnectedState;
+    const qint64 bytesRead = socket_->read(parser_.reserve(available), available);
+    if (bytesRead > 0)
+        parser_.commit(bytesRead);
+    processBuffer();
 }
 
-void TcpClient::onReadyRead()
+void TcpClientWorker::processBuffer()
 {
-    // 서버 응답 처리 - 라인 단위와 일반 데이터 모두 처리
-    while (socket_->canReadLine()) {
-        QByteArray data = socket_->readLine();
-        QString message = QString::fromUtf8(data).trimmed();
-
-        if (!message.isEmpty()) {
-            qInfo() << "Received message:" << message;
-            emit messageReceived(message);
+    // 이번에 읽은 데이터의 이벤트를 모아 GUI 스레드로 한 번에 보냄 (메시지마다 큐 이벤트를 만들지 않도록)
+    TcpEventBatch batch;
+    const bool ok = parser_.parse([this, &batch](const SensorEvent& event) {
+        // "ACK BIN1" 뒤에 이어 온 데이터는 같은 버퍼에서 바로 프레임으로 읽는다
+        if (framing_ == Framing::Negotiating && event.type == SensorEvent::Type::Ack
+            && event.textBytes() == Protocol::BinaryVersion) {
+            qInfo() << "Binary framing enabled";
+            finishNegotiation(Framing::Binary);
+            return;
         }
-    }
 
-    // 라인 단위로 읽을 수 없는 데이터도 처리
-    if (socket_->bytesAvailable() > 0) {
-        QByteArray data = socket_->readAll();
-        QString message = QString::fromUtf8(data).trimmed();
+        // 센서 값은 초당 수천 건까지 오므로 로그는 그 밖의 메시지만
+        if (event.type >= SensorEvent::Type::Ack)
+            qInfo() << "Received message:" << event.textBytes();
+        batch.append(event);
+    });
 
-        if (!message.isEmpty()) {
-            qInfo() << "Received message:" << message;
-            emit messageReceived(message);
-        }
+    if (!batch.isEmpty())
+        emit eventsReceived(batch);
+
+    if (!ok) {
+        // 경계를 잃은 스트림은 복구할 수 없으므로 연결을 다시 맺는다
+        qWarning() << "Invalid frame from server, resetting connection";
+        socket_->abort();
     }
 }
 
-void TcpClient::onDisconnected()
+void TcpClientWorker::onDisconnected()
 {
     qInfo() << "Disconnected from server";
+    connected_->store(false, std::memory_order_release);
+    pendingMessages_.clear();
+    finishNegotiation(Framing::Text);
     emit disconnected();
+    scheduleReconnect();
 }
 
-void TcpClient::onErrorOccurred(QAbstractSocket::SocketError error)
+void TcpClientWorker::onErrorOccurred(QAbstractSocket::SocketError error)
 {
     QString errorString = socket_->errorString();
     qWarning() << "Socket error:" << error << "-" << errorString;
     emit errorOccurred(errorString);
+    scheduleReconnect();
 }
 
-void TcpClient::onConnected()
+void TcpClientWorker::onConnected()
 {
     qInfo() << "Connected to server" << host_ << ":" << port_;
+    reconnectDelayMs_ = initialDelayMs_;
+    connected_->store(true, std::memory_order_release);
+    parser_.clear();
+    pendingMessages_.clear();
+    finishNegotiation(Framing::Text);
+
+    if (preferBinary_) {
+        writeData(Protocol::HelloBinary, Protocol::HelloBinary);
+        // 답을 기다리는 동안은 개행 없는 나머지를 메시지로 자르지 않는다 ("ACK BIN1" 이 나뉘어 올 수 있음)
+        framing_ = Framing::Negotiating;
+        parser_.setFlushPartialLines(false);
+        negotiateTimer_->start(NegotiateTimeoutMs);
+    }
     emit connected();
 }
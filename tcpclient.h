@@ -4,7 +4,18 @@
 #include <QObject>
 #include <QTcpSocket>
 #include <QAbstractSocket>
+#include <QTimer>
+#include <QThread>
+#include <QList>
+#include <atomic>
+#include "protocolparser.h"
 
+class TcpClientWorker;
+
+// 스마트홈 서버 TCP 클라이언트
+// - 소켓 읽기/파싱은 전용 네트워크 스레드(TcpClientWorker)에서 하므로 GUI 가 그리느라 바빠도 소켓은 계속 비워진다
+// - 한 번 읽은 데이터에서 나온 이벤트를 묶어 eventsReceived 한 번으로 GUI 스레드에 전달
+// - 아래 메서드는 GUI 스레드에서 부르며, 실제 동작은 네트워크 스레드에 넘겨 비동기로 처리된다
 class TcpClient : public QObject
 {
     Q_OBJECT
@@ -19,6 +30,15 @@ public:
     void sendMessage(const QString& message);
     bool isConnected() const;
 
+    // 연결 실패/끊김 시 자동 재연결 - 실패할 때마다 대기 시간을 2배로 늘림 (최대 maxDelayMs)
+    // disconnectFromHost() 를 직접 호출하면 자동 재연결도 멈춘다
+    void setAutoReconnect(bool enabled, int initialDelayMs = 500, int maxDelayMs = 30000);
+
+    // 연결할 때마다 바이너리 프레임(protocol.h) 협상 시도
+    // 서버가 NegotiateTimeoutMs 안에 "ACK BIN1" 로 답하지 않으면 기존 텍스트 방식 유지
+    void setBinaryFraming(bool enabled);
+    bool isBinaryFraming() const;
+
     // 창문 제어 명령 메서드만 (문서의 TCP 명령어 기반)
     void sendWindowOpen();   // "window_open" 명령 전송
     void sendWindowClose();  // "window_close" 명령 전송
@@ -28,7 +48,41 @@ public:
     void setWindowAngle(int angle); // 창문 각도 설정
 
 signals:
-    void messageReceived(const QString& message);
+    void eventsReceived(const TcpEventBatch& batch);
+    void connected();
+    void disconnected();
+    void errorOccurred(const QString& errorString);
+
+private:
+    // 작업자가 생성될 때 주소를 넘겨받으므로 worker_ 보다 먼저 선언 (초기화 순서)
+    std::atomic<bool> connected_;
+    std::atomic<bool> binaryFraming_;
+    QThread thread_;
+    TcpClientWorker* worker_;            // thread_ 에 속함 - 직접 호출하지 말고 invokeMethod 로
+};
+
+// 네트워크 스레드에서 동작하는 실제 소켓/파서 (TcpClient 내부용)
+class TcpClientWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    TcpClientWorker(std::atomic<bool>* connected, std::atomic<bool>* binaryFraming);
+
+    void connectToServer(const QString& host, quint16 port);
+    void disconnectFromHost();
+    void sendMessage(const QString& message);
+    void setAutoReconnect(bool enabled, int initialDelayMs, int maxDelayMs);
+    void setBinaryFraming(bool enabled);
+
+    // 종료 전 소켓을 닫고 타이머를 멈춤 (네트워크 스레드에서 호출)
+    void shutdown();
+
+    static constexpr int NegotiateTimeoutMs = 1000;
+    static constexpr int ShutdownWaitMs = 100;  // 종료 시 정상 종료를 기다리는 최대 시간
+
+signals:
+    void eventsReceived(const TcpEventBatch& batch);
     void connected();
     void disconnected();
     void errorOccurred(const QString& errorString);
@@ -40,9 +94,35 @@ private slots:
     void onConnected();
 
 private:
+    enum class Framing {
+        Text,         // 기존 텍스트 (개행 또는 세그먼트 단위)
+        Negotiating,  // HELLO BIN1 을 보내고 답을 기다리는 중 - 보낼 메시지는 대기열에
+        Binary        // 길이 접두 프레임
+    };
+
+    void scheduleReconnect();
+    void writeData(const QByteArray& data, const QString& message);
+    void finishNegotiation(Framing framing);
+    void processBuffer();
+
     QTcpSocket* socket_;
     QString host_;
     quint16 port_;
+
+    QTimer* reconnectTimer_;
+    bool autoReconnect_;
+    int initialDelayMs_;
+    int maxDelayMs_;
+    int reconnectDelayMs_;  // 다음 재연결까지 대기 시간
+
+    bool preferBinary_;
+    Framing framing_;
+    QTimer* negotiateTimer_;
+    QList<QString> pendingMessages_;  // 협상 중에 보낸 메시지
+    ProtocolParser parser_;           // 수신 버퍼 + 줄/프레임 해석
+
+    std::atomic<bool>* connected_;      // TcpClient 의 상태 (GUI 스레드에서 읽음)
+    std::atomic<bool>* binaryFraming_;
 };
 
 #endif // TCPCLIENT_H
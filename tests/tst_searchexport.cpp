@@ -0,0 +1,182 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "searchexport.h"
+#include "tscodec.h"
+
+// SearchExport::write 로 쓴 .hstx 파일을 read 로 다시 읽어 원본과 같은지 확인
+class TestSearchExport : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    QString filePath(const char* name) const { return m_dir.filePath(QLatin1String(name)); }
+
+    static QVector<qint64> makeTimes(int rows)
+    {
+        QVector<qint64> ts;
+        qint64 t = 1700000000000LL;
+        for (int i = 0; i < rows; ++i) {
+            t += 5000 + (i % 3) * 7;
+            ts.append(t);
+        }
+        return ts;
+    }
+
+    std::optional<SearchPage> roundTrip(const char* name, SearchCategory category, const SearchColumns& columns)
+    {
+        QString errorText;
+        if (!SearchExport::write(filePath(name), category, columns, &errorText)) {
+            qWarning() << "write 실패:" << errorText;
+            return std::nullopt;
+        }
+        std::optional<SearchPage> page = SearchExport::read(filePath(name), &errorText);
+        if (!page)
+            qWarning() << "read 실패:" << errorText;
+        return page;
+    }
+
+    struct RawColumn
+    {
+        QString name;
+        QStringList dictionary;
+        QVector<double> values;
+    };
+
+    // 헤더와 컬럼을 직접 지정해 .hstx 파일을 쓴다 (손상된 파일 흉내)
+    void writeRaw(const char* name, SearchCategory category, qint32 rows, const QVector<qint64>& ts,
+                  const QVector<RawColumn>& columns)
+    {
+        QFile file(filePath(name));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << quint32(0x48535458) << quint16(1) << quint8(category) << rows;
+        out << TsCodec::encodeTimestamps(ts.constData(), int(ts.size())) << quint8(columns.size());
+        for (const RawColumn& column : columns) {
+            out << column.name << column.dictionary
+                << TsCodec::encodeValues(column.values.constData(), int(column.values.size()));
+        }
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+    }
+
+    void homeEnv()
+    {
+        HomeEnvColumns c;
+        c.ts = makeTimes(5);
+        c.temperature = { 21.5f, 21.5f, 21.75f, 22.0f, -3.25f };
+        c.humidity = { 40.0f, 40.0f, 41.0f, 41.0f, 39.5f };
+        c.illumination = { 300, 310, 310, 0, 1023 };
+
+        const std::optional<SearchPage> page = roundTrip("home.hstx", SearchCategory::HomeEnv, c);
+        QVERIFY(page);
+        QCOMPARE(page->category, SearchCategory::HomeEnv);
+        QVERIFY(std::holds_alternative<HomeEnvColumns>(page->columns));
+        const HomeEnvColumns& r = std::get<HomeEnvColumns>(page->columns);
+        QCOMPARE(r.ts, c.ts);
+        QCOMPARE(r.temperature, c.temperature);
+        QCOMPARE(r.humidity, c.humidity);
+        QCOMPARE(r.illumination, c.illumination);
+    }
+
+    void eventDictionary()
+    {
+        EventColumns c;
+        c.ts = makeTimes(4);
+        for (const char* status : { "정상", "경고", "정상", "위험" }) {
+            c.status.append(c.statusNames.intern(QString::fromUtf8(status)));
+        }
+        c.level = { 120.0f, 800.0f, 130.0f, 1500.0f };
+
+        const std::optional<SearchPage> page = roundTrip("gas.hstx", SearchCategory::Gas, c);
+        QVERIFY(page);
+        QCOMPARE(page->category, SearchCategory::Gas);
+        const EventColumns& r = std::get<EventColumns>(page->columns);
+        QCOMPARE(r.ts, c.ts);
+        QCOMPARE(r.level, c.level);
+        QCOMPARE(r.status.size(), c.status.size());
+        for (int i = 0; i < c.size(); ++i)
+            QCOMPARE(r.statusNames.value(r.status[i]), c.statusNames.value(c.status[i]));
+    }
+
+    void petSharedDictionary()
+    {
+        PetColumns c;
+        c.ts = makeTimes(3);
+        c.food = { c.names.intern("충분"), c.names.intern("부족"), c.names.intern("충분") };
+        c.water = { c.names.intern("부족"), c.names.intern("충분"), c.names.intern("없음") };
+        c.toilet = { c.names.intern("깨끗"), c.names.intern("깨끗"), c.names.intern("더러움") };
+
+        const std::optional<SearchPage> page = roundTrip("pet.hstx", SearchCategory::Pet, c);
+        QVERIFY(page);
+        const PetColumns& r = std::get<PetColumns>(page->columns);
+        QCOMPARE(r.ts, c.ts);
+        QCOMPARE(r.food, c.food);
+        QCOMPARE(r.water, c.water);
+        QCOMPARE(r.toilet, c.toilet);
+        QCOMPARE(r.names.size(), c.names.size());
+    }
+
+    void emptyPlant()
+    {
+        const std::optional<SearchPage> page = roundTrip("plant.hstx", SearchCategory::Plant, PlantColumns());
+        QVERIFY(page);
+        QCOMPARE(std::get<PlantColumns>(page->columns).size(), 0);
+    }
+
+    void aggregateRejected()
+    {
+        QString errorText;
+        QVERIFY(!SearchExport::write(filePath("agg.hstx"), SearchCategory::HomeEnv, AggregateColumns(), &errorText));
+        QVERIFY(!errorText.isEmpty());
+    }
+
+    void truncatedFileRejected()
+    {
+        PlantColumns c;
+        c.ts = makeTimes(50);
+        for (int i = 0; i < 50; ++i)
+            c.soilMoisture.append(400 + i * 3);
+        QVERIFY(SearchExport::write(filePath("cut.hstx"), SearchCategory::Plant, c));
+
+        QFile file(filePath("cut.hstx"));
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(file.size() - 4));
+        file.close();
+
+        QString errorText;
+        QVERIFY(!SearchExport::read(filePath("cut.hstx"), &errorText));
+        QVERIFY(!errorText.isEmpty());
+    }
+
+    void oversizedRowCountRejected()
+    {
+        const QVector<qint64> ts = makeTimes(2);
+        writeRaw("rows.hstx", SearchCategory::Plant, 1 << 30, ts, { { "soil_moisture", {}, { 400.0, 410.0 } } });
+
+        QString errorText;
+        QVERIFY(!SearchExport::read(filePath("rows.hstx"), &errorText));
+        QVERIFY(!errorText.isEmpty());
+    }
+
+    void emptyDictionaryRejected()
+    {
+        const QVector<qint64> ts = makeTimes(2);
+        // 나머지는 정상인 파일에서 status 사전만 비어 있음
+        writeRaw("dict.hstx", SearchCategory::Fire, 2, ts,
+                 { { "status", {}, { 0.0, 1.0 } }, { "level", {}, { 12.0, 80.0 } } });
+
+        QString errorText;
+        QVERIFY(!SearchExport::read(filePath("dict.hstx"), &errorText));
+        QVERIFY(!errorText.isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(TestSearchExport)
+#include "tst_searchexport.moc"
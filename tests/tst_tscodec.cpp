@@ -0,0 +1,105 @@
+#include <QtTest>
+#include <cmath>
+#include <limits>
+#include "tscodec.h"
+
+// TsCodec 인코딩 -> 디코딩 결과가 원본과 비트 단위로 같은지 확인
+class TestTsCodec : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void checkValues(const QVector<double>& values)
+    {
+        const QByteArray encoded = TsCodec::encodeValues(values.constData(), int(values.size()));
+        QVector<double> decoded;
+        QVERIFY(TsCodec::decodeValues(encoded, int(values.size()), &decoded));
+        QCOMPARE(decoded.size(), values.size());
+        for (int i = 0; i < values.size(); ++i) {
+            // NaN/-0.0 도 그대로 돌아와야 하므로 비트로 비교
+            QCOMPARE(memcmp(&decoded[i], &values[i], sizeof(double)), 0);
+        }
+    }
+
+private slots:
+    void valuesPartialLastByte_data()
+    {
+        QTest::addColumn<QVector<double>>("values");
+        // 64 + 1 비트 = 마지막 바이트에 1 비트만 남는 경우
+        QTest::newRow("65 bits") << QVector<double>{ 21.5, 21.5 };
+        // 64 + 1 * 6 비트
+        QTest::newRow("70 bits") << QVector<double>(7, 45.0);
+        QTest::newRow("one value") << QVector<double>{ 3.25 };
+        QTest::newRow("small change") << QVector<double>{ 45.0, 46.0, 46.0, 47.0, 45.0 };
+        QTest::newRow("special") << QVector<double>{ 0.0, -0.0, std::numeric_limits<double>::quiet_NaN(),
+                                                     std::numeric_limits<double>::infinity(), 1e-300, -1e300 };
+    }
+
+    void valuesPartialLastByte()
+    {
+        QFETCH(QVector<double>, values);
+        checkValues(values);
+    }
+
+    void valuesRandom()
+    {
+        QRandomGenerator random(1234);
+        for (int round = 0; round < 50; ++round) {
+            QVector<double> values(1 + random.bounded(300));
+            double value = 20.0;
+            for (double& v : values) {
+                if (random.bounded(3) != 0)
+                    value += (random.bounded(200) - 100) / 10.0;
+                v = value;
+            }
+            checkValues(values);
+        }
+    }
+
+    void emptyValues()
+    {
+        QVERIFY(TsCodec::encodeValues(nullptr, 0).isEmpty());
+        QVector<double> decoded;
+        QVERIFY(TsCodec::decodeValues(QByteArray(), 0, &decoded));
+        QVERIFY(decoded.isEmpty());
+    }
+
+    void truncatedValuesFail()
+    {
+        const QVector<double> values{ 1.0, 2.0, 3.0, 4.0 };
+        QByteArray encoded = TsCodec::encodeValues(values.constData(), int(values.size()));
+        encoded.chop(1);
+        QVector<double> decoded;
+        QVERIFY(!TsCodec::decodeValues(encoded, int(values.size()), &decoded));
+    }
+
+    void oversizedCountFails()
+    {
+        // 데이터 크기로 불가능한 개수는 메모리를 잡기 전에 거부
+        const QByteArray small(4, '\0');
+        QVector<qint64> ts;
+        QVERIFY(!TsCodec::decodeTimestamps(small, 1 << 30, &ts));
+        QVERIFY(ts.capacity() < 1024);
+        QVector<double> values;
+        QVERIFY(!TsCodec::decodeValues(small, 1 << 30, &values));
+        QVERIFY(values.capacity() < 1024);
+        QVERIFY(!TsCodec::decodeValues(small, -1, &values));
+    }
+
+    void timestamps()
+    {
+        QVector<qint64> ts;
+        qint64 t = 1700000000000LL;
+        for (int i = 0; i < 1000; ++i) {
+            t += 1000 + (i % 7 == 0 ? 37 : 0) - (i % 11 == 0 ? 500 : 0);
+            ts.append(t);
+        }
+        const QByteArray encoded = TsCodec::encodeTimestamps(ts.constData(), int(ts.size()));
+        QVector<qint64> decoded;
+        QVERIFY(TsCodec::decodeTimestamps(encoded, int(ts.size()), &decoded));
+        QCOMPARE(decoded, ts);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestTsCodec)
+#include "tst_tscodec.moc"
@@ -0,0 +1,264 @@
+#include "tscodec.h"
+#include <cstring>
+
+namespace {
+
+// MSB 부터 채우는 비트 스트림
+class BitWriter
+{
+public:
+    explicit BitWriter(QByteArray& out) : m_out(out) {}
+
+    void write(quint64 bits, int count)
+    {
+        for (int i = count - 1; i >= 0; --i) {
+            m_current = quint8((m_current << 1) | ((bits >> i) & 1));
+            if (++m_used == 8) {
+                m_out.append(char(m_current));
+                m_current = 0;
+                m_used = 0;
+            }
+        }
+    }
+
+    // 마지막 남은 비트를 0 으로 채워 한 바이트로 기록 - 결과를 돌려주기 전에 반드시 호출
+    void flush()
+    {
+        if (m_used > 0) {
+            m_out.append(char(quint8(m_current << (8 - m_used))));
+            m_current = 0;
+            m_used = 0;
+        }
+    }
+
+private:
+    QByteArray& m_out;
+    quint8 m_current = 0;
+    int m_used = 0;
+};
+
+class BitReader
+{
+public:
+    explicit BitReader(const QByteArray& data) : m_data(data) {}
+
+    bool read(int count, quint64* bits)
+    {
+        quint64 value = 0;
+        for (int i = 0; i < count; ++i) {
+            const qsizetype byte = m_pos >> 3;
+            if (byte >= m_data.size())
+                return false;
+            const int shift = 7 - int(m_pos & 7);
+            value = (value << 1) | ((quint8(m_data[byte]) >> shift) & 1);
+            ++m_pos;
+        }
+        *bits = value;
+        return true;
+    }
+
+private:
+    const QByteArray& m_data;
+    qint64 m_pos = 0;
+};
+
+quint64 toBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int leadingZeros(quint64 v)
+{
+    int n = 0;
+    for (quint64 mask = quint64(1) << 63; mask && !(v & mask); mask >>= 1)
+        ++n;
+    return n;
+}
+
+int trailingZeros(quint64 v)
+{
+    int n = 0;
+    for (; n < 64 && !(v & 1); v >>= 1)
+        ++n;
+    return n;
+}
+
+} // namespace
+
+namespace TsCodec {
+
+void writeVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(char(quint8(value) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(quint8(value)));
+}
+
+bool readVarint(const char*& pos, const char* end, quint64* value)
+{
+    quint64 result = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        const quint8 byte = quint8(*pos++);
+        result |= quint64(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+QByteArray encodeTimestamps(const qint64* ts, int count)
+{
+    QByteArray out;
+    out.reserve(count + 16);
+    qint64 previous = 0;
+    qint64 previousDelta = 0;
+    for (int i = 0; i < count; ++i) {
+        if (i == 0) {
+            writeVarint(out, zigzag(ts[0]));
+        } else {
+            const qint64 delta = ts[i] - previous;
+            writeVarint(out, zigzag(i == 1 ? delta : delta - previousDelta));
+            previousDelta = delta;
+        }
+        previous = ts[i];
+    }
+    return out;
+}
+
+bool decodeTimestamps(const QByteArray& data, int count, QVector<qint64>* out)
+{
+    // 값마다 varint 가 최소 1바이트 - 손상된 개수로 큰 메모리를 잡지 않도록 먼저 확인
+    if (count < 0 || count > data.size())
+        return false;
+
+    const char* pos = data.constData();
+    const char* end = pos + data.size();
+    out->reserve(out->size() + count);
+
+    qint64 previous = 0;
+    qint64 previousDelta = 0;
+    for (int i = 0; i < count; ++i) {
+        quint64 raw;
+        if (!readVarint(pos, end, &raw))
+            return false;
+        if (i == 0) {
+            previous = unzigzag(raw);
+        } else {
+            previousDelta = i == 1 ? unzigzag(raw) : previousDelta + unzigzag(raw);
+            previous += previousDelta;
+        }
+        out->append(previous);
+    }
+    return true;
+}
+
+QByteArray encodeValues(const double* values, int count)
+{
+    QByteArray out;
+    out.reserve(count + 16);
+    BitWriter writer(out);
+
+    quint64 previous = 0;
+    int prevLeading = -1;
+    int prevTrailing = 0;
+    for (int i = 0; i < count; ++i) {
+        const quint64 bits = toBits(values[i]);
+        if (i == 0) {
+            writer.write(bits, 64);
+            previous = bits;
+            continue;
+        }
+
+        const quint64 x = bits ^ previous;
+        previous = bits;
+        if (x == 0) {
+            writer.write(0, 1);                 // 같은 값
+            continue;
+        }
+
+        writer.write(1, 1);
+        const int leading = qMin(leadingZeros(x), 31);
+        const int trailing = trailingZeros(x);
+        if (prevLeading >= 0 && leading >= prevLeading && trailing >= prevTrailing) {
+            // 이전 값의 의미 있는 비트 구간 안에 들어가면 구간 정보 없이 비트만
+            writer.write(0, 1);
+            const int meaningful = 64 - prevLeading - prevTrailing;
+            writer.write(x >> prevTrailing, meaningful);
+        } else {
+            const int meaningful = 64 - leading - trailing;
+            writer.write(1, 1);
+            writer.write(quint64(leading), 5);
+            writer.write(quint64(meaningful & 63), 6);  // 64 는 0 으로 저장
+            writer.write(x >> trailing, meaningful);
+            prevLeading = leading;
+            prevTrailing = trailing;
+        }
+    }
+    writer.flush();
+    return out;
+}
+
+bool decodeValues(const QByteArray& data, int count, QVector<double>* out)
+{
+    // 값마다 최소 1비트 - 손상된 개수로 큰 메모리를 잡지 않도록 먼저 확인
+    if (count < 0 || qint64(count) > qint64(data.size()) * 8)
+        return false;
+
+    BitReader reader(data);
+    out->reserve(out->size() + count);
+
+    quint64 previous = 0;
+    int prevLeading = 0;
+    int prevTrailing = 0;
+    for (int i = 0; i < count; ++i) {
+        quint64 bit;
+        if (i == 0) {
+            if (!reader.read(64, &previous))
+                return false;
+            out->append(fromBits(previous));
+            continue;
+        }
+
+        if (!reader.read(1, &bit))
+            return false;
+        if (bit == 0) {
+            out->append(fromBits(previous));
+            continue;
+        }
+
+        if (!reader.read(1, &bit))
+            return false;
+        if (bit == 1) {
+            quint64 leading, meaningful;
+            if (!reader.read(5, &leading) || !reader.read(6, &meaningful))
+                return false;
+            if (meaningful == 0)
+                meaningful = 64;
+            prevLeading = int(leading);
+            prevTrailing = 64 - prevLeading - int(meaningful);
+        }
+
+        const int meaningful = 64 - prevLeading - prevTrailing;
+        quint64 x;
+        if (!reader.read(meaningful, &x))
+            return false;
+        previous ^= x << prevTrailing;
+        out->append(fromBits(previous));
+    }
+    return true;
+}
+
+} // namespace TsCodec
@@ -0,0 +1,28 @@
+#ifndef TSCODEC_H
+#define TSCODEC_H
+
+#include <QByteArray>
+#include <QVector>
+
+// 센서 시계열 압축 코덱
+// - 시각: 첫 값 + 첫 간격 + 간격의 변화량(delta-of-delta)을 zig-zag varint 로 저장
+//         일정 주기로 들어오는 센서는 대부분 1바이트(0)로 줄어든다
+// - 값:   Gorilla 방식 XOR 비트 압축 - 이전 값과 같으면 1비트, 조금 바뀌면 의미 있는 비트만 저장
+// - 개수는 저장하지 않으므로 디코딩할 때 호출 측이 넘겨야 한다
+namespace TsCodec {
+
+inline quint64 zigzag(qint64 v) { return (quint64(v) << 1) ^ quint64(v >> 63); }
+inline qint64 unzigzag(quint64 v) { return qint64(v >> 1) ^ -qint64(v & 1); }
+
+void writeVarint(QByteArray& out, quint64 value);
+bool readVarint(const char*& pos, const char* end, quint64* value);
+
+QByteArray encodeTimestamps(const qint64* ts, int count);
+bool decodeTimestamps(const QByteArray& data, int count, QVector<qint64>* out);
+
+QByteArray encodeValues(const double* values, int count);
+bool decodeValues(const QByteArray& data, int count, QVector<double>* out);
+
+} // namespace TsCodec
+
+#endif // TSCODEC_H
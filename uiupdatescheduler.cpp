@@ -0,0 +1,86 @@
+#include "uiupdatescheduler.h"
+#include "profiler.h"
+#include <cmath>
+
+UiUpdateScheduler::UiUpdateScheduler(QObject *parent)
+    : QObject(parent)
+    , m_intervalMs(16)
+    , m_posted(0)
+    , m_applied(0)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &UiUpdateScheduler::flush);
+    m_sinceFlush.start();
+}
+
+void UiUpdateScheduler::setSlot(int slot, ApplyFn apply)
+{
+    if (slot >= m_slots.size())
+        m_slots.resize(slot + 1);
+    m_slots[slot].apply = std::move(apply);
+}
+
+void UiUpdateScheduler::setRate(double hz)
+{
+    if (hz <= 0)
+        return;
+    m_intervalMs = qMax(1, int(std::lround(1000.0 / hz)));
+}
+
+double UiUpdateScheduler::rate() const
+{
+    return 1000.0 / m_intervalMs;
+}
+
+void UiUpdateScheduler::post(int slot, int value)
+{
+    Q_ASSERT(slot >= 0 && slot < m_slots.size());
+    ++m_posted;
+
+    Slot& s = m_slots[slot];
+    s.value = value;
+    s.dirty = true;
+
+    if (!m_timer.isActive()) {
+        const qint64 remaining = m_intervalMs - m_sinceFlush.elapsed();
+        m_timer.start(int(qMax<qint64>(0, remaining)));
+    }
+}
+
+void UiUpdateScheduler::applyNow(int slot, int value)
+{
+    Q_ASSERT(slot >= 0 && slot < m_slots.size());
+    ++m_posted;
+    apply(m_slots[slot], value);
+}
+
+void UiUpdateScheduler::flush()
+{
+    PROFILE_SCOPE("UiUpdateScheduler::flush");
+    m_timer.stop();
+    m_sinceFlush.restart();
+
+    for (Slot& slot : m_slots) {
+        if (slot.dirty)
+            apply(slot, slot.value);
+    }
+}
+
+void UiUpdateScheduler::apply(Slot& slot, int value)
+{
+    slot.dirty = false;
+    ++m_applied;
+    if (slot.apply)
+        slot.apply(value);
+}
+
+quint64 UiUpdateScheduler::postedCount() const
+{
+    return m_posted;
+}
+
+quint64 UiUpdateScheduler::appliedCount() const
+{
+    return m_applied;
+}
@@ -0,0 +1,59 @@
+#ifndef UIUPDATESCHEDULER_H
+#define UIUPDATESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <functional>
+
+// 고빈도 센서 값의 화면 반영을 묶어 주는 스케줄러
+// - 카드(슬롯)마다 "최신 값" 한 칸만 두고, post() 는 값만 바꿔 둔다
+// - 슬롯이 처음 바뀌면 타이머를 걸어 rate Hz 에 한 번, 바뀐 슬롯만 apply 를 호출 (중간 값은 버림)
+// - 한동안 조용했다면 기다리지 않고 바로 반영하므로 드문 메시지는 지연이 없다
+// - applyNow() 는 기다리지 않고 즉시 반영 (위험 상태 전환 등), 대기 중이던 예전 값은 버린다
+class UiUpdateScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using ApplyFn = std::function<void(int value)>;
+
+    explicit UiUpdateScheduler(QObject *parent = nullptr);
+
+    // 슬롯 번호는 호출 측이 정한다 (MainWindow 의 UiCard)
+    void setSlot(int slot, ApplyFn apply);
+
+    // 초당 최대 반영 횟수 (기본 60, 화면 주사율에 맞추는 것을 권장)
+    void setRate(double hz);
+    double rate() const;
+
+    void post(int slot, int value);
+    void applyNow(int slot, int value);
+
+    // 대기 중인 값을 지금 모두 반영
+    void flush();
+
+    // 받은 값 수 / 실제로 반영한 수 (묶인 비율 확인용)
+    quint64 postedCount() const;
+    quint64 appliedCount() const;
+
+private:
+    struct Slot
+    {
+        ApplyFn apply;
+        int value = 0;
+        bool dirty = false;
+    };
+
+    void apply(Slot& slot, int value);
+
+    QVector<Slot> m_slots;
+    QTimer m_timer;
+    QElapsedTimer m_sinceFlush;  // 마지막 반영 이후 시간
+    int m_intervalMs;
+    quint64 m_posted;
+    quint64 m_applied;
+};
+
+#endif // UIUPDATESCHEDULER_H